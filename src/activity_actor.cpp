@@ -3690,6 +3690,8 @@ void craft_activity_actor::do_turn( player_activity &act, Character &crafter )
 
     // We already checked if this is nullptr above
     item &craft = *craft_item.get_item();
+    // The progress is kept on the craft itself
+    craft_item.mark_modified();
 
     const std::optional<tripoint_bub_ms> location = craft_item.where() == item_location::type::character
             ? std::optional<tripoint_bub_ms>() : std::optional<tripoint_bub_ms>( craft_item.pos_bub() );
@@ -4870,6 +4872,7 @@ void reload_activity_actor::finish( player_activity &act, Character &who )
         add_msg( m_info, _( "Can't reload the %s." ), reloadable_name );
         return;
     }
+    target_loc.mark_modified();
 
     if( ammo_is_filthy ) {
         reloadable.set_flag( flag_FILTHY );
@@ -5268,6 +5271,7 @@ void disassemble_activity_actor::do_turn( player_activity &act, Character &who )
 
     // We already checked if this is nullptr above
     item &craft = *target;
+    target.mark_modified();
 
     const std::optional<tripoint_bub_ms> location = target.where() == item_location::type::character
             ? std::optional<tripoint_bub_ms>() : std::optional<tripoint_bub_ms>( target.pos_bub() );
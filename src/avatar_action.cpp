@@ -1152,6 +1152,7 @@ void avatar_action::use_item( avatar &you, item_location &loc, std::string const
     if( loc->wetness && loc->has_flag( flag_WATER_BREAK_ACTIVE ) ) {
         if( query_yn( _( "This item is still wet and it will break if you turn it on. Proceed?" ) ) ) {
             loc->deactivate();
+            loc.mark_modified();
             loc.get_item()->set_fault( faults::random_of_type( "wet" ) );
             // An electronic item in water is also shorted.
             if( loc->has_flag( flag_ELECTRONIC ) ) {
@@ -1206,6 +1207,7 @@ void avatar_action::use_item( avatar &you, item_location &loc, std::string const
         update_lum( loc, false );
         you.use( loc, pre_obtain_moves, method );
         if( loc ) {
+            loc.mark_modified();
             update_lum( loc, true );
             loc.make_active();
         }
@@ -24,6 +24,7 @@
 #include "ballistics.h"
 #include "bodypart.h"
 #include "calendar.h"
+#include "cata_scope_helpers.h"
 #include "cata_utility.h"
 #include "character.h"
 #include "character_attire.h"
@@ -716,6 +717,7 @@ void npc::check_or_use_weapon_cbm( const bionic_id &cbm_id )
             set_wielded_item( cbm_weapon );
             mod_power_level( -bio.info().power_activate );
             bio.powered = true;
+            invalidate_flag_cache();
             weapon_bionic_uid = bio.get_uid();
         }
     }
@@ -728,6 +730,10 @@ void npc::check_or_use_weapon_cbm( const bionic_id &cbm_id )
 // share functions....
 bool Character::activate_bionic( bionic &bio, bool eff_only, bool *close_bionics_ui )
 {
+    // The bionic may be switched on or off again on any of the ways out
+    on_out_of_scope invalidate_flags( [this]() {
+        invalidate_flag_cache();
+    } );
     const bool mounted = is_mounted();
     if( bio.incapacitated_time > 0_turns ) {
         add_msg( m_info, _( "Your %s is shorting out and can't be activated." ),
@@ -1173,7 +1179,7 @@ bool Character::activate_bionic( bionic &bio, bool eff_only, bool *close_bionics
             }
         }
     }
-    bio_flag_cache.clear();
+    invalidate_flag_cache();
     // Recalculate stats (strength, mods from pain etc.) that could have been affected
     calc_encumbrance();
     reset();
@@ -1218,8 +1224,11 @@ ret_val<void> Character::can_deactivate_bionic( bionic &bio, bool eff_only ) con
 
 bool Character::deactivate_bionic( bionic &bio, bool eff_only )
 {
+    // The bionic is switched off below, and callers may have switched it off already
+    on_out_of_scope invalidate_flags( [this]() {
+        invalidate_flag_cache();
+    } );
     const auto can_deactivate = can_deactivate_bionic( bio, eff_only );
-    bio_flag_cache.clear();
     if( !can_deactivate.success() ) {
         if( !can_deactivate.str().empty() ) {
             add_msg( m_info,  can_deactivate.str() );
@@ -1638,6 +1647,7 @@ void Character::process_bionic( bionic &bio )
             bio.powered = false;
             add_msg_if_player( m_warning, _( "Your %s has lost connection and is turning off." ),
                                bio.info().name );
+            invalidate_flag_cache();
         }
     } else if( bio.id == bio_nanobots ) {
         std::forward_list<bodypart_id> bleeding_bp_parts;
@@ -2788,7 +2798,7 @@ bionic_uid Character::add_bionic( const bionic_id &b, bionic_uid parent_uid,
             wear_item( tmparmor, false );
         }
     }
-    bio_flag_cache.clear();
+    invalidate_flag_cache();
     invalidate_pseudo_items();
     update_bionic_power_capacity();
 
@@ -2874,7 +2884,7 @@ void Character::remove_bionic( const bionic &bio )
 
     const bool has_enchantments = !bio.id->enchantments.empty();
     *my_bionics = new_my_bionics;
-    bio_flag_cache.clear();
+    invalidate_flag_cache();
     update_last_bionic_uid();
     invalidate_pseudo_items();
     update_bionic_power_capacity();
@@ -3519,5 +3529,6 @@ void Character::force_bionic_deactivation( bionic &bio )
     bio.incapacitated_time = 0_turns;
     deactivate_bionic( bio, true );
     bio.powered = false;
+    invalidate_flag_cache();
     bio.incapacitated_time = old_time;
 }
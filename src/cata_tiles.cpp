@@ -33,6 +33,7 @@
 #include "filesystem.h"
 #include "game.h"
 #include "game_constants.h"
+#include "init.h"
 #include "input.h"
 #include "int_id.h"
 #include "item.h"
@@ -342,6 +343,10 @@ void cata_tiles::load_tileset( const std::string &tileset_id, const bool prechec
     tileset_mutation_overlay_ordering.clear();
 
     tileset_ptr = cache.load_tileset( tileset_id, renderer, precheck, force, pump_events );
+    // The new tileset may have been allocated where the old one was
+    resolved_for_tileset = nullptr;
+    resolved_terrain_tiles.clear();
+    resolved_furniture_tiles.clear();
 
     set_draw_scale( 16 );
 
@@ -1268,6 +1273,8 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
         return;
     }
 
+    resolve_tiles();
+
 #if defined(__ANDROID__)
     // Attempted bugfix for Google Play crash - prevent divide-by-zero if no tile
     // width/height specified
@@ -2247,6 +2254,16 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
             ll, -1, apply_night_vision_goggles, height_3d, intensity_level,
             variant, offset );
 }
+
+bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY category,
+                                      const std::optional<tile_lookup_res> *resolved_tile, const tripoint &pos,
+                                      int subtile, int rota, lit_level ll,
+                                      bool apply_night_vision_goggles, int &height_3d )
+{
+    return cata_tiles::draw_from_id_string_internal( id, category, empty_string, pos, subtile, rota,
+            ll, -1, apply_night_vision_goggles, height_3d, 0, "", point(), resolved_tile );
+}
+
 bool cata_tiles::draw_from_id_string_internal( const std::string &id, const tripoint &pos,
         int subtile,
         int rota,
@@ -2410,6 +2427,49 @@ cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
     }
 }
 
+void cata_tiles::resolve_tiles()
+{
+    const season_type season = season_of_year( calendar::turn );
+    const int data_generation = DynamicDataLoader::get_instance().get_data_generation();
+    if( resolved_for_tileset == tileset_ptr.get() && resolved_for_season == season &&
+        resolved_for_data == data_generation ) {
+        return;
+    }
+    resolved_terrain_tiles.clear();
+    resolved_furniture_tiles.clear();
+    resolved_for_tileset = tileset_ptr.get();
+    resolved_for_season = season;
+    resolved_for_data = data_generation;
+    if( !tileset_ptr ) {
+        return;
+    }
+    resolved_terrain_tiles.reserve( ter_t::count() );
+    for( size_t i = 0; i < ter_t::count(); ++i ) {
+        resolved_terrain_tiles.push_back( find_tile_looks_like(
+                                              ter_id( static_cast<int>( i ) ).id().str(), TILE_CATEGORY::TERRAIN, empty_string ) );
+    }
+    resolved_furniture_tiles.reserve( furn_t::count() );
+    for( size_t i = 0; i < furn_t::count(); ++i ) {
+        resolved_furniture_tiles.push_back( find_tile_looks_like(
+                                                furn_id( static_cast<int>( i ) ).id().str(), TILE_CATEGORY::FURNITURE, empty_string ) );
+    }
+}
+
+const std::optional<tile_lookup_res> *cata_tiles::find_resolved_tile( const TILE_CATEGORY category,
+        const int index ) const
+{
+    if( resolved_for_tileset != tileset_ptr.get() ||
+        resolved_for_data != DynamicDataLoader::get_instance().get_data_generation() ) {
+        return nullptr;
+    }
+    const std::vector<std::optional<tile_lookup_res>> &tiles = category == TILE_CATEGORY::TERRAIN
+            ? resolved_terrain_tiles : resolved_furniture_tiles;
+    if( index < 0 || static_cast<size_t>( index ) >= tiles.size() ) {
+        return nullptr;
+    }
+    return &tiles[index];
+}
+
 bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &overlay,
         const std::string &variant, std::string &draw_id )
 {
@@ -2486,7 +2546,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         int subtile, int rota, lit_level ll, int retract,
         bool apply_night_vision_goggles, int &height_3d,
         int intensity_level, const std::string &variant,
-        const point &offset )
+        const point &offset, const std::optional<tile_lookup_res> *resolved_tile )
 {
     bool nv_color_active = apply_night_vision_goggles && get_option<bool>( "NV_GREEN_TOGGLE" );
     // If the ID string does not produce a drawable tile
@@ -2539,7 +2599,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
     }
     // if a tile with intensity hasn't already been found then fall back to a base tile
     if( !res ) {
-        res = find_tile_looks_like( id, category, variant );
+        res = resolved_tile != nullptr ? *resolved_tile : find_tile_looks_like( id, category, variant );
         if( res ) {
             tt = &res -> tile();
         }
@@ -3310,7 +3370,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
         if( !neighborhood_overridden ) {
             return memorize_only
                    ? false
-                   : draw_from_id_string( tname, TILE_CATEGORY::TERRAIN, empty_string, p, subtile,
+                   : draw_from_id_string( tname, TILE_CATEGORY::TERRAIN,
+                                          find_resolved_tile( TILE_CATEGORY::TERRAIN, t.to_i() ), p, subtile,
                                           rotation, ll, nv_goggles_activated, height_3d );
         }
     }
@@ -3339,7 +3400,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             const bool nv = overridden ? false : nv_goggles_activated;
             return memorize_only
                    ? false
-                   : draw_from_id_string( tname, TILE_CATEGORY::TERRAIN, empty_string, p, subtile,
+                   : draw_from_id_string( tname, TILE_CATEGORY::TERRAIN,
+                                          find_resolved_tile( TILE_CATEGORY::TERRAIN, t2.to_i() ), p, subtile,
                                           rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] ) {
@@ -3401,7 +3463,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         if( !neighborhood_overridden ) {
             return memorize_only
                    ? false
-                   : draw_from_id_string( fname, TILE_CATEGORY::FURNITURE, empty_string, p, subtile,
+                   : draw_from_id_string( fname, TILE_CATEGORY::FURNITURE,
+                                          find_resolved_tile( TILE_CATEGORY::FURNITURE, f.to_i() ), p, subtile,
                                           rotation, ll, nv_goggles_activated, height_3d );
         }
     }
@@ -3440,7 +3503,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             const bool nv = overridden ? false : nv_goggles_activated;
             return memorize_only
                    ? false
-                   : draw_from_id_string( fname, TILE_CATEGORY::FURNITURE, empty_string, p, subtile,
+                   : draw_from_id_string( fname, TILE_CATEGORY::FURNITURE,
+                                          find_resolved_tile( TILE_CATEGORY::FURNITURE, f2.to_i() ), p, subtile,
                                           rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] ) {
@@ -464,6 +464,15 @@ class cata_tiles
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category, const std::string &variant,
                               int looks_like_jumps_limit = 10 ) const;
 
+        /** Finds the tiles of all terrain and furniture again if the tileset, season or data changed */
+        void resolve_tiles();
+        /**
+         * Tile of the terrain or furniture with the given int_id index, as find_tile_looks_like
+         * found it without a variant. Returns nullptr if it has to be looked up by id.
+         */
+        const std::optional<tile_lookup_res> *find_resolved_tile( TILE_CATEGORY category,
+                int index ) const;
+
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
         std::optional<tile_lookup_res>
@@ -496,13 +505,19 @@ class cata_tiles
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int intensity_level,
                                   const std::string &variant, const point &offset );
+        // Draws a tile found by find_resolved_tile, looking it up by id if there is none
+        bool draw_from_id_string( const std::string &id, TILE_CATEGORY category,
+                                  const std::optional<tile_lookup_res> *resolved_tile, const tripoint &pos,
+                                  int subtile, int rota, lit_level ll, bool apply_night_vision_goggles,
+                                  int &height_3d );
         bool draw_from_id_string_internal( const std::string &id, const tripoint &pos, int subtile,
                                            int rota,
                                            lit_level ll, int retract, bool apply_night_vision_goggles, int &height_3d );
         bool draw_from_id_string_internal( const std::string &id, TILE_CATEGORY category,
                                            const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                            lit_level ll, int retract, bool apply_night_vision_goggles, int &height_3d, int intensity_level,
-                                           const std::string &variant, const point &offset );
+                                           const std::string &variant, const point &offset,
+                                           const std::optional<tile_lookup_res> *resolved_tile = nullptr );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -752,6 +767,14 @@ class cata_tiles
         tileset_cache &cache;
         std::shared_ptr<const tileset> tileset_ptr;
 
+        // Tiles of terrain and furniture by the index of their int_id, so that drawing them
+        // doesn't hash their ids every frame. See resolve_tiles.
+        std::vector<std::optional<tile_lookup_res>> resolved_terrain_tiles;
+        std::vector<std::optional<tile_lookup_res>> resolved_furniture_tiles;
+        const tileset *resolved_for_tileset = nullptr;
+        season_type resolved_for_season = NUM_SEASONS;
+        int resolved_for_data = -1;
+
         // the scaled default sprite width and height. in non-isometric mode,
         // the basic tile width and height equal the default sprite width and
         // height, but in isometric mode, the basic tile height is always
@@ -31,6 +31,7 @@
 #include "output.h"
 #include "pinyin.h"
 #include "rng.h"
+#include "save_writer.h"
 #include "string_formatter.h"
 #include "translation.h"
 #include "translations.h"
@@ -285,14 +286,32 @@ float multi_lerp( const std::vector<std::pair<float, float>> &points, float x )
     return ( t * points[i].second ) + ( ( 1 - t ) * points[i - 1].second );
 }
 
-void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+static void write_to_path( const fs::path &path,
+                           const std::function<void( std::ostream & )> &writer )
 {
+    cata::save_writer &save_writer = get_save_writer();
+    if( cata::deferred_saves::active() ) {
+        std::ostringstream buffer;
+        writer( buffer );
+        if( !buffer ) {
+            throw std::runtime_error( "serializing failed" );
+        }
+        save_writer.write( path, buffer.str() );
+        return;
+    }
+    // Otherwise a queued older version would replace this one once it is written
+    save_writer.wait_for( path );
     // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
-    ofstream_wrapper fout( fs::u8path( path ), std::ios::binary );
+    ofstream_wrapper fout( path, std::ios::binary );
     writer( fout.stream() );
     fout.close();
 }
 
+void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
+{
+    write_to_path( fs::u8path( path ), writer );
+}
+
 bool write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer,
                     const char *const fail_message )
 {
@@ -317,10 +336,7 @@ bool write_to_file( const std::string &path, const std::function<void( std::ostr
 
 void write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer )
 {
-    // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
-    ofstream_wrapper fout( path.get_unrelative_path(), std::ios::binary );
-    writer( fout.stream() );
-    fout.close();
+    write_to_path( path.get_unrelative_path(), writer );
 }
 
 bool write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer,
@@ -476,6 +492,7 @@ std::unique_ptr<std::istream> read_maybe_compressed_file( const std::string &pat
 
 std::unique_ptr<std::istream> read_maybe_compressed_file( const fs::path &path )
 {
+    get_save_writer().wait_for( path );
     try {
         std::ifstream fin( path, std::ios::binary );
         if( !fin ) {
@@ -519,6 +536,7 @@ std::optional<std::string> read_whole_file( const std::string &path )
 
 std::optional<std::string> read_whole_file( const fs::path &path )
 {
+    get_save_writer().wait_for( path );
     std::string outstring;
     try {
         std::ifstream fin( path, std::ios::binary );
@@ -562,6 +580,7 @@ std::optional<std::string> read_whole_file( const cata_path &path )
 bool read_from_file_json( const cata_path &path,
                           const std::function<void( const JsonValue & )> &reader )
 {
+    get_save_writer().wait_for( path.get_unrelative_path() );
     try {
         JsonValue jo = json_loader::from_path( path );
         reader( jo );
@@ -576,10 +595,7 @@ bool read_from_file_json( const cata_path &path,
 bool read_from_file_optional( const std::string &path,
                               const std::function<void( std::istream & )> &reader )
 {
-    // Note: slight race condition here, but we'll ignore it. Worst case: the file
-    // exists and got removed before reading it -> reading fails with a message
-    // Or file does not exists, than everything works fine because it's optional anyway.
-    return file_exist( path ) && read_from_file( path, reader );
+    return read_from_file_optional( fs::u8path( path ), reader );
 }
 
 bool read_from_file_optional( const fs::path &path,
@@ -588,6 +604,7 @@ bool read_from_file_optional( const fs::path &path,
     // Note: slight race condition here, but we'll ignore it. Worst case: the file
     // exists and got removed before reading it -> reading fails with a message
     // Or file does not exists, than everything works fine because it's optional anyway.
+    get_save_writer().wait_for( path );
     return file_exist( path ) && read_from_file( path, reader );
 }
 
@@ -600,6 +617,7 @@ bool read_from_file_optional( const cata_path &path,
 bool read_from_file_optional_json( const cata_path &path,
                                    const std::function<void( const JsonValue & )> &reader )
 {
+    get_save_writer().wait_for( path.get_unrelative_path() );
     return file_exist( path.get_unrelative_path() ) && read_from_file_json( path, reader );
 }
 
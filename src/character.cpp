@@ -680,6 +680,7 @@ item_location Character::get_wielded_item()
 void Character::set_wielded_item( const item &to_wield )
 {
     weapon = to_wield;
+    crafting_cache.valid = false;
 }
 
 std::vector<matype_id> Character::known_styles( bool teachable_only ) const
@@ -3144,6 +3145,8 @@ units::mass Character::weight_carried() const
 void Character::invalidate_weight_carried_cache()
 {
     cached_weight_carried = std::nullopt;
+    // Whatever changed what we carry also changes what we can craft with
+    crafting_cache.valid = false;
 }
 
 units::mass Character::best_nearby_lifting_assist() const
@@ -3362,6 +3365,7 @@ ret_val<void> Character::can_unwield( const item &it ) const
 void Character::invalidate_inventory_validity_cache()
 {
     cache_inventory_is_valid = false;
+    crafting_cache.valid = false;
 }
 bool Character::is_wielding( const item &target ) const
 {
@@ -3606,6 +3610,7 @@ void Character::normalize()
     weapon = item( "null", calendar::turn_zero );
 
     set_body();
+    invalidate_flag_cache();
     recalc_hp();
     set_all_parts_temp_conv( BODYTEMP_NORM );
     set_stamina( get_stamina_max() );
@@ -7638,6 +7643,7 @@ void Character::recalculate_bodyparts()
             body[bp] = bodypart( bp );
         }
     }
+    invalidate_flag_cache();
     tally_organic_size();
     recalc_limb_energy_usage();
 
@@ -7700,6 +7706,8 @@ void Character::recalculate_enchantment_cache()
             }
         }
     }
+    // Enchantments can grant mutations
+    invalidate_flag_cache();
 
     if( enchantment_cache->modifies_bodyparts() ) {
         recalculate_bodyparts();
@@ -9460,6 +9468,7 @@ bool Character::has_charges( const itype_id &it, int quantity,
 std::list<item> Character::use_amount( const itype_id &it, int quantity,
                                        const std::function<bool( const item & )> &filter, bool select_ind )
 {
+    crafting_cache.valid = false;
     std::list<item> ret;
     if( select_ind && !it->count_by_charges() ) {
         std::vector<item *> tmp = items_with( [&it, &filter]( const item & itm ) -> bool {
@@ -9580,6 +9589,7 @@ std::list<item> Character::use_charges( const itype_id &what, int qty, const int
 {
     std::list<item> res;
     inventory inv = crafting_inventory( pos(), radius, true );
+    crafting_cache.valid = false;
 
     if( qty <= 0 ) {
         return res;
@@ -9870,6 +9880,8 @@ void Character::on_effect_int_change( const efftype_id &eid, int intensity,
     }
 
     morale->on_effect_int_change( eid, intensity, bp );
+    // Last, as the effect is only erased after this for a removal
+    invalidate_flag_cache();
 }
 
 void Character::on_mutation_gain( const trait_id &mid )
@@ -11652,6 +11664,7 @@ bool Character::unload( item_location &loc, bool bypass_activity,
     }
 
     add_msg( _( "You unload your %s." ), target->tname() );
+    loc.mark_modified();
 
     if( it.has_flag( flag_MAG_DESTROY ) && it.ammo_remaining() == 0 ) {
         loc.remove_item();
@@ -11804,6 +11817,14 @@ int Character::count_bodypart_with_flag( const json_character_flag &flag ) const
         if( bp->has_flag( flag ) ) {
             ret++;
         }
+    }
+    return ret + count_conditional_bodypart_flag( flag );
+}
+
+int Character::count_conditional_bodypart_flag( const json_character_flag &flag ) const
+{
+    int ret = 0;
+    for( const bodypart_id &bp : get_all_body_parts() ) {
         if( get_part( bp )->has_conditional_flag( flag ) ) {
             bool disabled = false;
             if( has_effect_with_flag( flag_EFFECT_LIMB_DISABLE_CONDITIONAL_FLAGS ) ) {
@@ -11822,19 +11843,90 @@ int Character::count_bodypart_with_flag( const json_character_flag &flag ) const
     return ret;
 }
 
+const Character::flag_cache_data &Character::get_flag_cache() const
+{
+    if( flag_cache ) {
+        return *flag_cache;
+    }
+    flag_cache_data &cache = flag_cache.emplace();
+    std::unordered_map<json_character_flag, int> &counts = cache.counts;
+    // Counted the same way as in count_trait_flag, count_bionic_with_flag and so on
+    for( const trait_id &mut : get_mutations() ) {
+        const mutation_branch &mut_data = mut.obj();
+        for( const json_character_flag &flag : mut_data.flags ) {
+            counts[flag]++;
+        }
+        if( mut_data.activated ) {
+            const bool active = has_active_mutation( mut );
+            for( const json_character_flag &flag : active ? mut_data.active_flags :
+                 mut_data.inactive_flags ) {
+                if( mut_data.flags.count( flag ) == 0 ) {
+                    counts[flag]++;
+                }
+            }
+        }
+    }
+    for( const bionic &bio : *my_bionics ) {
+        const bionic_data &bio_data = bio.info();
+        for( const json_character_flag &flag : bio_data.flags ) {
+            counts[flag]++;
+        }
+        if( bio_data.activated ) {
+            const bool active = has_active_bionic( bio.id );
+            for( const json_character_flag &flag : active ? bio_data.active_flags :
+                 bio_data.inactive_flags ) {
+                counts[flag]++;
+            }
+        }
+    }
+    // Effects count once per flag, however many of them have it
+    std::unordered_set<json_character_flag> effect_flags;
+    for( const auto &elem : *effects ) {
+        effect_flags.insert( elem.first->get_flags().begin(), elem.first->get_flags().end() );
+        for( const auto &eff : elem.second ) {
+            if( const ma_buff *buff = ma_buff::from_effect( eff.second ) ) {
+                for( const json_character_flag &flag : buff->flags ) {
+                    counts[flag]++;
+                }
+            }
+        }
+    }
+    for( const json_character_flag &flag : effect_flags ) {
+        counts[flag]++;
+    }
+    for( const bodypart_id &bp : get_all_body_parts() ) {
+        for( const json_character_flag &flag : bp->flags ) {
+            counts[flag]++;
+        }
+        cache.conditional.insert( bp->conditional_flags.begin(), bp->conditional_flags.end() );
+    }
+    return cache;
+}
+
+void Character::invalidate_flag_cache()
+{
+    bio_flag_cache.clear();
+    flag_cache.reset();
+}
+
 bool Character::has_flag( const json_character_flag &flag ) const
 {
-    // If this is a performance problem create a map of flags stored for a character and updated on trait, mutation, bionic add/remove, activate/deactivate, effect gain/loss
-    return has_trait_flag( flag ) ||
-           has_bionic_with_flag( flag ) ||
-           has_effect_with_flag( flag ) ||
-           has_bodypart_with_flag( flag ) ||
-           has_mabuff_flag( flag );
+    return count_flag( flag ) > 0;
 }
 
 int Character::count_flag( const json_character_flag &flag ) const
 {
-    // If this is a performance problem create a map of flags stored for a character and updated on trait, mutation, bionic add/remove, activate/deactivate, effect gain/loss
+    const flag_cache_data &cache = get_flag_cache();
+    const auto iter = cache.counts.find( flag );
+    int ret = iter == cache.counts.end() ? 0 : iter->second;
+    if( cache.conditional.count( flag ) > 0 ) {
+        ret += count_conditional_bodypart_flag( flag );
+    }
+    return ret;
+}
+
+int Character::count_flag_uncached( const json_character_flag &flag ) const
+{
     return count_trait_flag( flag ) +
            count_bionic_with_flag( flag ) +
            has_effect_with_flag( flag ) +
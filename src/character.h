@@ -1386,6 +1386,10 @@ class Character : public Creature, public visitable
         bool has_flag( const json_character_flag &flag ) const;
         /** Returns the count of traits, bionics, effects, bodyparts, and martial arts buffs with a flag */
         int count_flag( const json_character_flag &flag ) const;
+        /** Same as count_flag, but checks every trait, bionic, effect and bodypart instead of the flag cache */
+        int count_flag_uncached( const json_character_flag &flag ) const;
+        /** Drops the cached flags, to be called whenever traits, bionics, effects or bodyparts change */
+        void invalidate_flag_cache();
         /** Returns the trait id with the given invlet, or an empty string if no trait has that invlet */
         trait_id trait_by_invlet( int ch ) const;
         /** Returns the vector of all traits in category, good/bad/any */
@@ -3721,6 +3725,16 @@ class Character : public Creature, public visitable
         bool leak_level_dirty = true;
         // Cache if current bionic layout has certain json flag. Refreshed upon bionics add/remove, activation/deactivation.
         mutable std::map<const json_character_flag, bool> bio_flag_cache;
+        struct flag_cache_data {
+            // How many traits, bionics, effects, bodyparts and martial arts buffs have a flag
+            std::unordered_map<json_character_flag, int> counts;
+            // Bodypart flags that depend on the health and encumbrance of the part, counted on every query
+            std::unordered_set<json_character_flag> conditional;
+        };
+        // Rebuilt on the first query after invalidate_flag_cache()
+        mutable std::optional<flag_cache_data> flag_cache;
+        const flag_cache_data &get_flag_cache() const;
+        int count_conditional_bodypart_flag( const json_character_flag &flag ) const;
     public:
         float get_leak_level() const;
         /** Iterate through the character inventory to get its leak level */
@@ -4113,12 +4127,21 @@ class Character : public Creature, public visitable
 
         struct weighted_int_list<std::string> melee_miss_reasons;
 
+        /**
+         * The crafting inventory is reused only within the turn and moves it was formed in, since
+         * map items change in place (charges, rot, active processing) without the map noticing.
+         * Within that window it is still dropped when our own items change (which clear
+         * @ref valid), when the map contents generation moves on, or when where and how far we
+         * look changes.
+         */
         struct crafting_cache_type {
             bool valid = false; // other fields are only valid if this flag is true
-            time_point time;
             int moves;
+            time_point time;
+            unsigned int map_generation;
             tripoint position;
             int radius;
+            bool clear_path;
             pimpl<inventory> crafting_inventory;
         };
         mutable crafting_cache_type crafting_cache;
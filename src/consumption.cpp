@@ -1935,6 +1935,9 @@ trinary Character::consume( item_location loc, bool force )
     if( result != trinary::NONE ) {
         handler.unseal_pocket_containing( loc );
     }
+    if( result == trinary::SOME ) {
+        loc.mark_modified();
+    }
     if( result == trinary::ALL ) {
         if( loc.where() == item_location::type::character ) {
             i_rem( loc.get_item() );
@@ -660,17 +660,21 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     if( src_pos == tripoint_zero ) {
         inv_pos = pos();
     }
+    map &here = get_map();
     if( crafting_cache.valid
         && moves == crafting_cache.moves
         && radius == crafting_cache.radius
-        && calendar::turn == crafting_cache.time
+        && clear_path == crafting_cache.clear_path
         && inv_pos == crafting_cache.position
+        && here.get_contents_generation() == crafting_cache.map_generation
+        && calendar::turn == crafting_cache.time
       ) {
         return *crafting_cache.crafting_inventory;
     }
     crafting_cache.crafting_inventory->clear();
     if( radius >= 0 ) {
-        crafting_cache.crafting_inventory->form_from_map( inv_pos, radius, this, false, clear_path );
+        crafting_cache.crafting_inventory->form_from_map( here, inv_pos, radius, this, false,
+                clear_path );
     }
 
     std::map<itype_id, int> tmp_liq_list;
@@ -706,8 +710,10 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     crafting_cache.valid = true;
     crafting_cache.moves = moves;
     crafting_cache.time = calendar::turn;
+    crafting_cache.map_generation = here.get_contents_generation();
     crafting_cache.position = inv_pos;
     crafting_cache.radius = radius;
+    crafting_cache.clear_path = clear_path;
     return *crafting_cache.crafting_inventory;
 }
 
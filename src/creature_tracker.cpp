@@ -1,6 +1,7 @@
 #include "creature_tracker.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <ostream>
 #include <string>
@@ -9,6 +10,7 @@
 
 #include "avatar.h"
 #include "cata_assert.h"
+#include "coordinates.h"
 #include "debug.h"
 #include "flood_fill.h"
 #include "game.h"
@@ -93,6 +95,7 @@ bool creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.get_location()] = critter_ptr;
+    place_in_grid( critter );
     return true;
 }
 
@@ -129,6 +132,7 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( old_pos );
         monsters_by_location[new_pos] = *iter;
+        place_in_grid( **iter );
         return true;
     } else {
         // We're changing the x/y/z coordinates of a zombie that hasn't been added
@@ -143,6 +147,8 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
 
 void creature_tracker::remove_from_location_map( const monster &critter )
 {
+    remove_from_grid( critter );
+
     const auto pos_iter = monsters_by_location.find( critter.get_location() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
         monsters_by_location.erase( pos_iter );
@@ -160,6 +166,85 @@ void creature_tracker::remove_from_location_map( const monster &critter )
     }
 }
 
+void creature_tracker::place_in_grid( monster &critter )
+{
+    const tripoint_abs_sm sm = project_to<coords::sm>( critter.get_location() );
+    const auto iter = submap_of_monster.find( &critter );
+    if( iter != submap_of_monster.end() ) {
+        if( iter->second == sm ) {
+            return;
+        }
+        remove_from_grid( critter );
+    }
+    submap_of_monster.emplace( &critter, sm );
+    monsters_by_submap[sm].push_back( &critter );
+}
+
+void creature_tracker::remove_from_grid( const monster &critter )
+{
+    const auto iter = submap_of_monster.find( &critter );
+    if( iter == submap_of_monster.end() ) {
+        return;
+    }
+    const auto cell_iter = monsters_by_submap.find( iter->second );
+    submap_of_monster.erase( iter );
+    if( cell_iter == monsters_by_submap.end() ) {
+        return;
+    }
+    std::vector<monster *> &cell = cell_iter->second;
+    const auto in_cell = std::find( cell.begin(), cell.end(), &critter );
+    if( in_cell != cell.end() ) {
+        *in_cell = cell.back();
+        cell.pop_back();
+    }
+    if( cell.empty() ) {
+        monsters_by_submap.erase( cell_iter );
+    }
+}
+
+std::vector<monster *> creature_tracker::monsters_near( const tripoint_abs_ms &center, int range,
+        int z_range ) const
+{
+    std::vector<monster *> result;
+    const tripoint extent( range, range, z_range );
+    const tripoint_abs_sm lo = project_to<coords::sm>( center - extent );
+    const tripoint_abs_sm hi = project_to<coords::sm>( center + extent );
+    const auto visit_cell = [&]( const std::vector<monster *> &cell ) {
+        for( monster *critter : cell ) {
+            const tripoint offset = ( critter->get_location() - center ).raw();
+            if( std::abs( offset.x ) <= range && std::abs( offset.y ) <= range &&
+                std::abs( offset.z ) <= z_range && !critter->is_dead() ) {
+                result.push_back( critter );
+            }
+        }
+    };
+
+    // Probing every submap in range only pays off while there are more occupied submaps
+    // than submaps in range, otherwise it's cheaper to go through the occupied ones.
+    const size_t submaps_in_range = static_cast<size_t>( hi.x() - lo.x() + 1 ) *
+                                    ( hi.y() - lo.y() + 1 ) * ( hi.z() - lo.z() + 1 );
+    if( submaps_in_range > monsters_by_submap.size() ) {
+        for( const auto &[sm, cell] : monsters_by_submap ) {
+            if( sm.x() >= lo.x() && sm.x() <= hi.x() && sm.y() >= lo.y() && sm.y() <= hi.y() &&
+                sm.z() >= lo.z() && sm.z() <= hi.z() ) {
+                visit_cell( cell );
+            }
+        }
+        return result;
+    }
+    for( int z = lo.z(); z <= hi.z(); ++z ) {
+        for( int y = lo.y(); y <= hi.y(); ++y ) {
+            for( int x = lo.x(); x <= hi.x(); ++x ) {
+                const auto iter = monsters_by_submap.find( tripoint_abs_sm( x, y, z ) );
+                if( iter != monsters_by_submap.end() ) {
+                    visit_cell( iter->second );
+                }
+            }
+        }
+    }
+    return result;
+}
+
 void creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -180,6 +265,8 @@ void creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    submap_of_monster.clear();
     removed_this_turn_.clear();
     creatures_by_zone_and_faction_.clear();
     invalidate_reachability_cache();
@@ -188,8 +275,11 @@ void creature_tracker::clear()
 void creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    submap_of_monster.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
         monsters_by_location[mon_ptr->get_location()] = mon_ptr;
+        place_in_grid( *mon_ptr );
     }
 }
 
@@ -249,9 +339,11 @@ void creature_tracker::swap_positions( monster &first, monster &second )
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
         monsters_by_location[first.get_location()] = first_ptr;
+        place_in_grid( *first_ptr );
     }
     if( second_ptr ) {
         monsters_by_location[second.get_location()] = second_ptr;
+        place_in_grid( *second_ptr );
     }
 }
 
@@ -129,6 +129,16 @@ class creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Returns the monsters that are at most @p range tiles away from @p center on either
+         * horizontal axis and at most @p z_range z-levels above or below it.
+         * Only the submaps that can hold such monsters are looked at, so this is much cheaper
+         * than going through all monsters when most of them are far away.
+         * Dead monsters are ignored and not returned.
+         */
+        std::vector<monster *> monsters_near( const tripoint_abs_ms &center, int range,
+                                              int z_range ) const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( const JsonArray &ja );
 
@@ -140,8 +150,11 @@ class creature_tracker
         }
 
     private:
-        /** Remove the monsters entry in @ref monsters_by_location */
+        /** Remove the monsters entry in @ref monsters_by_location and @ref monsters_by_submap */
         void remove_from_location_map( const monster &critter );
+        /** Files the monster under the submap it is currently on in @ref monsters_by_submap */
+        void place_in_grid( monster &critter );
+        void remove_from_grid( const monster &critter );
 
         void flood_fill_zone( const Creature &origin );
 
@@ -154,6 +167,11 @@ class creature_tracker
         std::vector<shared_ptr_fast<monster>> monsters_list;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>> monsters_by_location;
+        // The same monsters grouped by the submap they are on, for @ref monsters_near
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<tripoint_abs_sm, std::vector<monster *>> monsters_by_submap;
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<const monster *, tripoint_abs_sm> submap_of_monster;
 
         /**
          * Creatures that get removed via @ref remove are stored here until the end of the turn.
@@ -77,6 +77,7 @@
 #include "map.h"
 #include "map_extras.h"
 #include "map_iterator.h"
+#include "mapbuffer.h"
 #include "mapgen.h"
 #include "mapgendata.h"
 #include "martialarts.h"
@@ -99,15 +100,19 @@
 #include "pimpl.h"
 #include "point.h"
 #include "popup.h"
+#include "profiling.h"
 #include "recipe_dictionary.h"
 #include "relic.h"
 #include "requirements.h"
 #include "ret_val.h"
+#include "sight_cache.h"
 #include "skill.h"
+#include "slab_pool.h"
 #include "sounds.h"
 #include "stomach.h"
 #include "string_formatter.h"
 #include "string_input_popup.h"
+#include "submap.h"
 #include "talker.h"
 #include "tgz_archiver.h"
 #include "timed_event.h"
@@ -270,6 +275,8 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
 		case debug_menu::debug_menu_index::SIX_MILLION_DOLLAR_SURVIVOR: return "SIX_MILLION_DOLLAR_SURVIVOR";
 		case debug_menu::debug_menu_index::EDIT_FACTION: return "EDIT_FACTION";
 		case debug_menu::debug_menu_index::WRITE_CITY_LIST: return "WRITE_CITY_LIST";
+		case debug_menu::debug_menu_index::TURN_PROFILER: return "TURN_PROFILER";
+		case debug_menu::debug_menu_index::MAP_ALLOCATIONS: return "MAP_ALLOCATIONS";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -790,6 +797,8 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::DISPLAY_RADIATION, true, 'R', _( "Toggle display radiation" ) ) },
             { uilist_entry( debug_menu_index::SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( debug_menu_index::BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
+            { uilist_entry( debug_menu_index::TURN_PROFILER, true, 'P', _( "Turn profiler" ) ) },
+            { uilist_entry( debug_menu_index::MAP_ALLOCATIONS, true, 'o', _( "Show map memory pools" ) ) },
             { uilist_entry( debug_menu_index::HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
             { uilist_entry( debug_menu_index::TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
@@ -3609,6 +3618,69 @@ static void wind_speed()
     }
 }
 
+static void turn_profiler_menu()
+{
+    uilist menu;
+    menu.text = profiling::enabled() ? _( "Turn profiler (running)" ) : _( "Turn profiler (stopped)" );
+    menu.addentry( 0, true, 't', profiling::enabled() ? _( "Stop profiling" ) :
+                   _( "Start profiling" ) );
+    menu.addentry( 1, true, 'r', _( "Show timings of recent turns" ) );
+    menu.addentry( 2, true, 'c', _( "Write per-turn timings to turn_profile.csv" ) );
+    menu.addentry( 3, true, 'j', _( "Write Chrome trace to turn_profile.json" ) );
+    menu.addentry( 4, true, 'l', _( "Show line of sight cache hit rate" ) );
+    menu.query();
+    switch( menu.ret ) {
+        case 0:
+            profiling::set_enabled( !profiling::enabled() );
+            break;
+        case 1: {
+            const auto new_win = []() {
+                return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                           point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                                  std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+            };
+            scrollable_text( new_win, _( "Turn profiler" ), profiling::report() );
+            break;
+        }
+        case 2:
+            if( profiling::write_csv( cata_path( cata_path::root_path::unknown, "turn_profile.csv" ) ) ) {
+                popup( _( "Turn timings written to turn_profile.csv" ) );
+            }
+            break;
+        case 3:
+            if( profiling::write_chrome_trace( cata_path( cata_path::root_path::unknown,
+                                               "turn_profile.json" ) ) ) {
+                popup( _( "Turn trace written to turn_profile.json" ) );
+            }
+            break;
+        case 4: {
+            const sight_cache_stats &stats = get_map().get_sight_cache_stats();
+            const uint64_t lookups = stats.hits + stats.misses;
+            popup( _( "Line of sight checks answered from the cache: %d of %d (%.1f%%)\n"
+                      "Cache dropped %d times" ), stats.hits, lookups,
+                   lookups == 0 ? 0.0 : 100.0 * stats.hits / lookups, stats.invalidations );
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void show_map_allocations()
+{
+    const auto describe = []( const char *name, const cata::slab_stats & stats ) {
+        return string_format( _( "%s: %d live, %d free, %d slabs, %d bytes each\n" ), name, stats.live,
+                              stats.free, stats.slabs, stats.block_size );
+    };
+    const submap_item_stats items = MAPBUFFER.item_stats();
+    popup( "%s%s%s\n%s", describe( _( "Submaps" ), submap::allocation_stats() ),
+           describe( _( "Submap tiles" ), maptile_soa::allocation_stats() ),
+           string_format( _( "Buffered map quads: %d" ), MAPBUFFER.quad_count() ),
+           string_format( _( "Items on buffered submaps: %d in %d slots, %d bytes, %d bytes per submap" ),
+                          items.items, items.slots, items.bytes,
+                          items.submaps == 0 ? 0 : items.bytes / items.submaps ) );
+}
+
 static void write_city_list()
 {
     write_to_file( "cities.output", [&]( std::ostream & testfile ) {
@@ -3679,6 +3751,8 @@ void debug()
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::UNLOCK_ALL,
         debug_menu_index::BENCHMARK,
+        debug_menu_index::TURN_PROFILER,
+        debug_menu_index::MAP_ALLOCATIONS,
         debug_menu_index::SHOW_MSG,
         debug_menu_index::QUICKLOAD,
         debug_menu_index::QUIT_NOSAVE,
@@ -4165,6 +4239,14 @@ void debug()
             faction_edit_menu();
             break;
 
+        case debug_menu_index::TURN_PROFILER:
+            turn_profiler_menu();
+            break;
+
+        case debug_menu_index::MAP_ALLOCATIONS:
+            show_map_allocations();
+            break;
+
         case debug_menu_index::WRITE_CITY_LIST:
             write_city_list();
 
@@ -113,6 +113,8 @@ enum class debug_menu_index : int {
     SIX_MILLION_DOLLAR_SURVIVOR,
     EDIT_FACTION,
     WRITE_CITY_LIST,
+    TURN_PROFILER,
+    MAP_ALLOCATIONS,
     last
 };
 
@@ -23,6 +23,7 @@
 #include "bionics.h"
 #include "cached_options.h"
 #include "calendar.h"
+#include "cata_scope_helpers.h"
 #include "cata_variant.h"
 #include "clzones.h"
 #include "coordinates.h"
@@ -57,12 +58,15 @@
 #include "player_activity.h"
 #include "point.h"
 #include "popup.h"
+#include "profiling.h"
 #include "rng.h"
+#include "save_writer.h"
 #include "scent_map.h"
 #include "sdlsound.h"
 #include "sounds.h"
 #include "stats_tracker.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "timed_event.h"
 #include "translations.h"
 #include "type_id.h"
@@ -102,6 +106,9 @@ namespace turn_handler
 {
 bool cleanup_at_end()
 {
+    // Anything below may move or delete the save
+    get_save_writer().flush();
+    report_background_save_errors();
     avatar &u = get_avatar();
     if( g->uquit == QUIT_DIED || g->uquit == QUIT_SUICIDE ) {
         // Put (non-hallucinations) into the overmap so they are not lost.
@@ -260,12 +267,55 @@ void handle_key_blocking_activity()
 
 namespace
 {
+// Lets the worker threads work out what the monsters can see before any of them acts, so that
+// monster::plan mostly looks the answers up instead of tracing lines of sight one by one.
+static void plan_monster_sight()
+{
+    // Fewer than this are not worth waking the workers for
+    constexpr size_t min_parallel_monsters = 16;
+    if( !worker_threads_enabled() ) {
+        return;
+    }
+    std::vector<monster *> planners;
+    for( monster &critter : g->all_monsters() ) {
+        if( !critter.has_effect( effect_ridden ) && !critter.has_effect( effect_controlled ) ) {
+            planners.push_back( &critter );
+        }
+    }
+    if( planners.size() < min_parallel_monsters ) {
+        return;
+    }
+
+    map &m = get_map();
+    // Whatever the workers read that is filled in lazily must be filled in beforehand: missing
+    // level caches, and the ids resolved while looking at characters.
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        m.get_cache_ref( z );
+    }
+    static_cast<void>( get_avatar().visibility() );
+    for( npc &guy : g->all_npcs() ) {
+        static_cast<void>( guy.get_monster_faction() );
+        static_cast<void>( guy.visibility() );
+    }
+
+    m.freeze_sight_caches( true );
+    on_out_of_scope thaw( [&m]() {
+        m.freeze_sight_caches( false );
+    } );
+    get_thread_pool().parallel_for( planners.size(), [&planners]( const size_t i ) {
+        planners[i]->plan_sight();
+    } );
+}
+
 void monmove()
 {
+    profiling::scoped_zone profile( profiling::zone::monmove );
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
 
+    plan_monster_sight();
+
     for( monster &critter : g->all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos_bub() ) &&
@@ -317,6 +367,7 @@ void monmove()
             critter.process_triggers();
             m.creature_in_field( critter );
         }
+        critter.forget_planned_sight();
 
         if( !critter.is_dead() &&
             u.has_active_bionic( bio_alarm ) &&
@@ -440,6 +491,7 @@ void overmap_npc_move()
 // Returns true if game is over (death, saved, quit, etc)
 bool do_turn()
 {
+    profiling::scoped_turn profile;
     if( g->is_game_over() ) {
         return turn_handler::cleanup_at_end();
     }
@@ -554,6 +606,7 @@ bool do_turn()
 
     if( !u.has_effect( effect_sleep ) || g->uquit == QUIT_WATCH ) {
         if( u.get_moves() > 0 || g->uquit == QUIT_WATCH ) {
+            profiling::scoped_zone profile_actions( profiling::zone::player_actions );
             while( u.get_moves() > 0 || g->uquit == QUIT_WATCH ) {
                 g->cleanup_dead();
                 g->mon_info_update();
@@ -164,6 +164,9 @@ class effect_type
 
         /** Check if the effect type has the specified flag */
         bool has_flag( const flag_id &flag ) const;
+        const std::set<flag_id> &get_flags() const {
+            return flags;
+        }
 
         const time_duration &intensity_duration() const {
             return int_dur_factor;
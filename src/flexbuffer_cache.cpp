@@ -144,14 +144,18 @@ struct flexbuffer_vector_storage : flexbuffer_storage {
 
 struct flexbuffer_mmap_storage : flexbuffer_storage {
     std::shared_ptr<mmap_file> mmap_handle_;
+    // Bytes at the start of the file that are not part of the flexbuffer
+    size_t offset_;
 
-    explicit flexbuffer_mmap_storage( std::shared_ptr<mmap_file> mmap_handle ) : mmap_handle_{ std::move( mmap_handle ) } {}
+    explicit flexbuffer_mmap_storage( std::shared_ptr<mmap_file> mmap_handle,
+                                      size_t offset = 0 ) : mmap_handle_{ std::move( mmap_handle ) },
+        offset_{ offset } {}
 
     const uint8_t *data() const override {
-        return mmap_handle_->base;
+        return mmap_handle_->base + offset_;
     }
     size_t size() const override {
-        return mmap_handle_->len;
+        return mmap_handle_->len - offset_;
     }
 };
 
@@ -228,6 +232,33 @@ struct string_flexbuffer : parsed_flexbuffer {
         std::string source_;
 };
 
+// A flexbuffer that was stored as is, there is no json text it was parsed from.
+struct binary_flexbuffer : parsed_flexbuffer {
+        binary_flexbuffer( std::shared_ptr<flexbuffer_storage> &&storage, fs::path &&path )
+            : parsed_flexbuffer{ std::move( storage ) },
+              path_{ std::move( path ) } {}
+
+        ~binary_flexbuffer() override = default;
+
+        bool is_stale() const override {
+            return false;
+        }
+
+        std::unique_ptr<std::istream> get_source_stream() const override {
+            // Only used to report errors, so print the flexbuffer back as json.
+            std::string source;
+            flexbuffers::GetRoot( storage_->data(), storage_->size() ).ToString( true, true, source );
+            return std::make_unique<std::istringstream>( std::move( source ) );
+        }
+
+        fs::path get_source_path() const noexcept override {
+            return path_;
+        }
+
+    private:
+        fs::path path_;
+};
+
 class flexbuffer_disk_cache
 {
     public:
@@ -425,14 +456,33 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse( fs::path json_source
                offset );
 }
 
+std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::map_binary( fs::path flexbuffer_path,
+        const std::string &header )
+{
+    std::shared_ptr<mmap_file> mapped = mmap_file::map_file( flexbuffer_path );
+    if( !mapped ) {
+        throw std::runtime_error( "Failed to mmap " + flexbuffer_path.generic_u8string() );
+    }
+    // Anything shorter can't hold the header and a flexbuffer root.
+    if( mapped->len < header.size() + 3 ||
+        std::memcmp( mapped->base, header.data(), header.size() ) != 0 ) {
+        throw std::runtime_error( "Unrecognized binary format in " + flexbuffer_path.generic_u8string() );
+    }
+    auto storage = std::make_shared<flexbuffer_mmap_storage>( std::move( mapped ), header.size() );
+    return std::make_shared<binary_flexbuffer>( std::move( storage ), std::move( flexbuffer_path ) );
+}
+
 std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     fs::path lexically_normal_json_source_path, size_t offset )
 {
 
     // Is our cache potentially stale?
     if( disk_cache_ ) {
-        std::shared_ptr<flexbuffer_mmap_storage> cached_storage = disk_cache_->load_flexbuffer_if_not_stale(
-                    lexically_normal_json_source_path );
+        std::shared_ptr<flexbuffer_mmap_storage> cached_storage;
+        {
+            std::lock_guard<std::mutex> lock( disk_cache_mutex_ );
+            cached_storage = disk_cache_->load_flexbuffer_if_not_stale( lexically_normal_json_source_path );
+        }
         if( cached_storage ) {
             std::error_code ec;
             fs::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
@@ -455,6 +505,7 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     std::vector<uint8_t> fb = parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
 
     if( disk_cache_ ) {
+        std::lock_guard<std::mutex> lock( disk_cache_mutex_ );
         disk_cache_->save_to_disk( lexically_normal_json_source_path, fb );
     }
 
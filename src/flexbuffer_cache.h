@@ -4,7 +4,10 @@
 
 #include <iosfwd>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <flatbuffers/flexbuffers.h>
 
@@ -56,12 +59,19 @@ class flexbuffer_cache
         ~flexbuffer_cache();
 
         // Throw exceptions on IO and parse errors.
+        // These may be called from several threads at once.
         static shared_flexbuffer parse( fs::path json_source_path, size_t offset = 0 ) noexcept( false );
         shared_flexbuffer parse_and_cache( fs::path lexically_normal_json_source_path,
                                            size_t offset = 0 ) noexcept( false ) ;
 
         static shared_flexbuffer parse_buffer( std::string buffer ) noexcept( false );
 
+        // Maps a file that holds the given header followed by a FlexBuffer, such as one built
+        // through JsonOut, without any parsing. Throws if the file can't be mapped or does not
+        // start with the header.
+        static shared_flexbuffer map_binary( fs::path flexbuffer_path,
+                                             const std::string &header ) noexcept( false );
+
     private:
         flexbuffer_cache( flexbuffer_cache && ) noexcept = default;
 
@@ -69,6 +79,8 @@ class flexbuffer_cache
 
         // Map of original json file path to disk serialized FlexBuffer path and mtime of input.
         std::unique_ptr<flexbuffer_disk_cache> disk_cache_;
+        // Guards disk_cache_, the parsing itself happens outside of it.
+        std::mutex disk_cache_mutex_;
 };
 
 #endif // CATA_SRC_FLEXBUFFER_CACHE_H
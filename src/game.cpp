@@ -177,6 +177,7 @@
 #include "ret_val.h"
 #include "rng.h"
 #include "safemode_ui.h"
+#include "save_writer.h"
 #include "scenario.h"
 #include "scent_map.h"
 #include "scores_ui.h"
@@ -12597,6 +12598,49 @@ point game::update_map( Character &p, bool z_level_changed )
     return update_map( p2.x, p2.y, z_level_changed );
 }
 
+// Guesses which way the reality bubble shifts next, from the vehicle the avatar is in or else
+// from the last shift, and has the map buffer start reading the quads that would come into
+// view from the save files in the background.
+static void prefetch_submaps_ahead( const map &m, const avatar &u, const point &last_shift )
+{
+    // NOLINTNEXTLINE(cata-use-named-point-constants)
+    const inclusive_rectangle<point> size_1( point( -1, -1 ), point( 1, 1 ) );
+    point dir = clamp( last_shift, size_1 );
+    if( const optional_vpart_position vp = m.veh_at( u.pos_bub() ) ) {
+        const vehicle &veh = vp->vehicle();
+        if( veh.velocity != 0 ) {
+            const units::angle heading = veh.velocity > 0 ? veh.move.dir() : veh.move.dir() + 180_degrees;
+            dir = point( std::lround( units::cos( heading ) ), std::lround( units::sin( heading ) ) );
+        }
+    }
+    if( dir == point_zero ) {
+        return;
+    }
+
+    // The two columns/rows of submaps beyond the edge, i.e. the next two shifts.
+    const tripoint_abs_sm origin = m.get_abs_sub();
+    const int my_mapsize = m.getmapsize();
+    std::set<tripoint_abs_omt> quads;
+    for( int i = 0; i < 2; ++i ) {
+        for( int j = -2; j < my_mapsize + 2; ++j ) {
+            std::vector<point> edge;
+            if( dir.x != 0 ) {
+                edge.emplace_back( dir.x > 0 ? my_mapsize + i : -1 - i, j );
+            }
+            if( dir.y != 0 ) {
+                edge.emplace_back( j, dir.y > 0 ? my_mapsize + i : -1 - i );
+            }
+            for( const point &sm : edge ) {
+                for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+                    quads.insert( project_to<coords::omt>(
+                                      tripoint_abs_sm( origin.xy() + sm, z ) ) );
+                }
+            }
+        }
+    }
+    MAPBUFFER.prefetch_quads( std::vector<tripoint_abs_omt>( quads.begin(), quads.end() ) );
+}
+
 point game::update_map( int &x, int &y, bool z_level_changed )
 {
     point shift;
@@ -12626,6 +12670,9 @@ point game::update_map( int &x, int &y, bool z_level_changed )
             // We may be able to see farther now that the z-level has changed.
             update_overmap_seen();
         }
+        if( u.in_vehicle ) {
+            prefetch_submaps_ahead( m, u, shift );
+        }
         // Not actually shifting the submaps, all the stuff below would do nothing
         return point_zero;
     }
@@ -12640,6 +12687,9 @@ point game::update_map( int &x, int &y, bool z_level_changed )
         remaining_shift -= this_shift;
     }
 
+    // Submaps that scrolled off the map may be dropped, nothing refers to them anymore
+    MAPBUFFER.evict_cold_quads();
+
     // Shift monsters
     shift_monsters( tripoint( shift, 0 ) );
     const point shift_ms = sm_to_ms_copy( shift );
@@ -12684,6 +12734,8 @@ point game::update_map( int &x, int &y, bool z_level_changed )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    prefetch_submaps_ahead( m, u, shift );
+
     return shift;
 }
 
@@ -13052,8 +13104,15 @@ void game::quicksave()
 
     time_t now = std::time( nullptr ); //timestamp for start of saving procedure
 
+    // Whatever went wrong while writing the last save
+    report_background_save_errors();
     //perform save
-    save();
+    if( get_option<bool>( "BACKGROUND_SAVES" ) ) {
+        cata::deferred_saves deferred;
+        save();
+    } else {
+        save();
+    }
     //Now reset counters for autosaving, so we don't immediately autosave after a quicksave or autosave.
     moves_since_last_save = 0;
     last_save_timestamp = now;
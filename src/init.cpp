@@ -1,6 +1,10 @@
 #include "init.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <exception>
+#include <future>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -97,8 +101,10 @@
 #include "speech.h"
 #include "speed_description.h"
 #include "start_location.h"
+#include "string_formatter.h"
 #include "test_data.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -517,16 +523,50 @@ void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::s
         files.emplace_back( path );
     }
 
+    // Parsing a file into a flexbuffer does not depend on any other file, so that is done ahead
+    // on the worker threads. Handing the objects to their loaders stays on this thread and in
+    // file order, as later files may refer to what earlier ones defined.
+    cata::thread_pool &pool = get_thread_pool();
+    // Only parse a few files ahead, so that not every file of a mod is held in memory at once.
+    const size_t parse_ahead = std::min( files.size(), static_cast<size_t>( pool.num_workers() ) * 4 );
+    std::vector<std::future<JsonValue>> parsed( files.size() );
+    const auto start_parsing = [&]( size_t i ) {
+        std::shared_ptr<std::promise<JsonValue>> promise = std::make_shared<std::promise<JsonValue>>();
+        parsed[i] = promise->get_future();
+        pool.submit( [promise, file = files[i]]() {
+            try {
+                promise->set_value( json_loader::from_path( file ) );
+            } catch( ... ) {
+                promise->set_exception( std::current_exception() );
+            }
+        } );
+    };
+    for( size_t i = 0; i < parse_ahead; ++i ) {
+        start_parsing( i );
+    }
+
+    std::chrono::steady_clock::duration parse_time{};
+    std::chrono::steady_clock::duration load_time{};
     // iterate over each file
-    for( const cata_path &file : files ) {
+    for( size_t i = 0; i < files.size(); ++i ) {
+        const cata_path &file = files[i];
         try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
+            // parse it, or wait for it to be parsed
+            const std::chrono::steady_clock::time_point parse_start = std::chrono::steady_clock::now();
+            JsonValue jsin = parsed[i].valid() ? parsed[i].get() : json_loader::from_path( file );
+            if( parse_ahead > 0 && i + parse_ahead < files.size() ) {
+                start_parsing( i + parse_ahead );
+            }
+            const std::chrono::steady_clock::time_point load_start = std::chrono::steady_clock::now();
+            parse_time += load_start - parse_start;
             load_all_from_json( jsin, src, path, file );
+            load_time += std::chrono::steady_clock::now() - load_start;
         } catch( const JsonError &err ) {
             throw std::runtime_error( err.what() );
         }
     }
+    load_timings.emplace_back( string_format( "Parsing %s", path.generic_u8string() ), parse_time );
+    load_timings.emplace_back( string_format( "Loading %s", path.generic_u8string() ), load_time );
 }
 
 void DynamicDataLoader::load_all_from_json( const JsonValue &jsin, const std::string &src,
@@ -552,6 +592,7 @@ void DynamicDataLoader::load_all_from_json( const JsonValue &jsin, const std::st
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    load_timings.clear();
 
     achievement::reset();
     activity_type::reset();
@@ -769,14 +810,35 @@ void DynamicDataLoader::finalize_loaded_data()
 
     for( const named_entry &e : entries ) {
         loading_ui::show( _( "Finalizing" ), e.first );
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         e.second();
+        load_timings.emplace_back( string_format( "Finalizing %s", e.first ),
+                                   std::chrono::steady_clock::now() - start );
     }
 
     if( !get_option<bool>( "SKIP_VERIFICATION" ) ) {
         check_consistency();
     }
     finalized = true;
+    ++data_generation;
     loading_ui::done();
+    log_load_timings();
+}
+
+void DynamicDataLoader::log_load_timings() const
+{
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    std::chrono::steady_clock::duration total{};
+    for( const std::pair<std::string, std::chrono::steady_clock::duration> &timing : load_timings ) {
+        total += timing.second;
+    }
+    std::ostream &out = DebugLog( D_INFO, DC_ALL );
+    out << "Data loading took " << duration_cast<milliseconds>( total ).count() << " ms";
+    for( const std::pair<std::string, std::chrono::steady_clock::duration> &timing : load_timings ) {
+        out << "\n  " << timing.first << ": " << duration_cast<milliseconds>( timing.second ).count()
+            << " ms";
+    }
 }
 
 void DynamicDataLoader::check_consistency()
@@ -874,7 +936,10 @@ void DynamicDataLoader::check_consistency()
 
     for( const named_entry &e : entries ) {
         loading_ui::show( _( "Verifying" ), e.first );
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         e.second();
+        load_timings.emplace_back( string_format( "Verifying %s", e.first ),
+                                   std::chrono::steady_clock::now() - start );
     }
     loading_ui::done();
 }
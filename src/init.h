@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_INIT_H
 #define CATA_SRC_INIT_H
 
+#include <chrono>
 #include <functional>
 #include <iosfwd>
 #include <list>
@@ -65,11 +66,18 @@ class DynamicDataLoader
 
     private:
         bool finalized = false;
+        // How often the data has been finalized, see get_data_generation
+        int data_generation = 0;
 
         struct cached_streams;
 
         std::unique_ptr<cached_streams> stream_cache;
 
+        /** Wall time of each loading phase, in the order they ran since the last @ref unload_data */
+        std::vector<std::pair<std::string, std::chrono::steady_clock::duration>> load_timings;
+        /** Writes @ref load_timings to the debug log */
+        void log_load_timings() const;
+
     protected:
         /**
          * Maps the type string (coming from json) to the
@@ -172,6 +180,23 @@ class DynamicDataLoader
             return finalized;
         }
 
+        /**
+         * Changes every time the data is finalized, which is when ids may start referring to
+         * different objects. Lets caches keyed by int ids tell when they went stale.
+         */
+        int get_data_generation() const {
+            return data_generation;
+        }
+
+        /**
+         * Returns how long each phase of loading, finalizing and checking the data took, in the
+         * order they ran. These are also written to the debug log once the data is finalized.
+         */
+        const std::vector<std::pair<std::string, std::chrono::steady_clock::duration>>
+        &get_load_timings() const {
+            return load_timings;
+        }
+
         /**
          * Get a possibly cached stream for deferred data loading. If the cached
          * stream is still in use by outside code, this returns a new stream to
@@ -309,7 +309,7 @@ item::item( const itype *type, time_point turn, int qty ) : type( type ), bday(
     if( type->countdown_interval > 0_seconds ) {
         countdown_point = calendar::turn + type->countdown_interval;
     }
-    item_vars = type->item_variables;
+    item_vars = item_var_store( type->item_variables );
 
     update_prefix_suffix_flags();
     if( has_flag( flag_CORPSE ) ) {
@@ -645,6 +645,7 @@ item &item::convert( const itype_id &new_type, Character *carrier )
     type = find_type( new_type );
     set_relative_rot( rel_rot );
     requires_tags_processing = true; // new type may have "active" flags
+    cached_base_measures.reset();
     item temp( *this );
     temp.contents = item_contents( type->pockets );
     for( const item *it : contents.mods() ) {
@@ -1712,7 +1713,7 @@ stacking_info item::stacks_with( const item &rhs, bool check_components, bool co
     // Guns that differ only by dirt/shot_counter can still stack,
     // but other item_vars such as label/note will prevent stacking
     static const std::set<std::string> ignore_keys = { "dirt", "shot_counter", "spawn_location_omt", "ethereal" };
-    bits.set( tname::segments::VARS, map_equal_ignoring_keys( item_vars, rhs.item_vars, ignore_keys ) );
+    bits.set( tname::segments::VARS, item_vars.equal_ignoring_keys( rhs.item_vars, ignore_keys ) );
     bits.set( tname::segments::ETHEREAL, _stacks_ethereal( *this, rhs ) );
     bits.set( tname::segments::LOCATION_HINT, _stacks_location_hint( *this, rhs ) );
 
@@ -1821,41 +1822,43 @@ void item::force_insert_item( const item &it, pocket_type pk_type )
 
 void item::set_var( const std::string &name, const int value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, static_cast<int64_t>( value ) );
+    cached_base_measures.reset();
 }
 
 void item::set_var( const std::string &name, const long long value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, static_cast<int64_t>( value ) );
+    cached_base_measures.reset();
 }
 
 // NOLINTNEXTLINE(cata-no-long)
 void item::set_var( const std::string &name, const long value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, static_cast<int64_t>( value ) );
+    cached_base_measures.reset();
 }
 
 void item::set_var( const std::string &name, const double value )
 {
-    item_vars[name] = string_format( "%f", value );
+    // Stored the way it is saved, so it reads the same before and after saving
+    item_vars.set_string( name, string_format( "%f", value ) );
+    cached_base_measures.reset();
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const item_var_store::value *var = item_vars.find( name );
+    if( var == nullptr ) {
         return default_value;
     }
-    const std::string &val = it->second;
+    if( const int64_t *integer = std::get_if<int64_t>( var ) ) {
+        return static_cast<double>( *integer );
+    }
+    if( const double *floating = std::get_if<double>( var ) ) {
+        return *floating;
+    }
+    const std::string val = item_var_store::to_string( *var );
     char *end;
     errno = 0;
     double result = strtod( val.data(), &end );
@@ -1888,16 +1891,20 @@ double item::get_var( const std::string &name, const double default_value ) cons
 
 void item::set_var( const std::string &name, const tripoint &value )
 {
-    item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    item_vars.set( name, value );
+    cached_base_measures.reset();
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const item_var_store::value *var = item_vars.find( name );
+    if( var == nullptr ) {
         return default_value;
     }
-    std::vector<std::string> values = string_split( it->second, ',' );
+    if( const tripoint *p = std::get_if<tripoint>( var ) ) {
+        return *p;
+    }
+    std::vector<std::string> values = string_split( item_var_store::to_string( *var ), ',' );
     cata_assert( values.size() == 3 );
     auto convert_or_error = []( const std::string_view s ) {
         ret_val<int> result = try_parse_integer<int>( s, false );
@@ -1915,16 +1922,17 @@ tripoint item::get_var( const std::string &name, const tripoint &default_value )
 
 void item::set_var( const std::string &name, const std::string &value )
 {
-    item_vars[name] = value;
+    item_vars.set_string( name, value );
+    cached_base_measures.reset();
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const item_var_store::value *var = item_vars.find( name );
+    if( var == nullptr ) {
         return default_value;
     }
-    return it->second;
+    return item_var_store::to_string( *var );
 }
 
 std::string item::get_var( const std::string &name ) const
@@ -1934,23 +1942,25 @@ std::string item::get_var( const std::string &name ) const
 
 std::optional<std::string> item::maybe_get_var( const std::string &name ) const
 {
-    const auto it = item_vars.find( name );
-    return it == item_vars.end() ? std::nullopt : std::optional<std::string> { it->second };
+    const item_var_store::value *var = item_vars.find( name );
+    return var == nullptr ? std::nullopt : std::optional<std::string> { item_var_store::to_string( *var ) };
 }
 
 bool item::has_var( const std::string &name ) const
 {
-    return item_vars.count( name ) > 0;
+    return item_vars.find( name ) != nullptr;
 }
 
 void item::erase_var( const std::string &name )
 {
     item_vars.erase( name );
+    cached_base_measures.reset();
 }
 
 void item::clear_vars()
 {
     item_vars.clear();
+    cached_base_measures.reset();
 }
 
 // TODO: Get rid of, handle multiple types gracefully
@@ -2429,8 +2439,7 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
 
     if( parts->test( iteminfo_parts::DESCRIPTION ) ) {
         insert_separation_line( info );
-        const std::map<std::string, std::string>::const_iterator idescription =
-            item_vars.find( "description" );
+        const std::optional<std::string> idescription = maybe_get_var( "description" );
         const std::optional<translation> snippet = SNIPPET.get_snippet_by_id( snip_id );
         if( snippet.has_value() ) {
             // Just use the dynamic description
@@ -2449,8 +2458,8 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
                 //note that you have seen the snippet
                 get_avatar().add_snippet( snip_id );
             }
-        } else if( idescription != item_vars.end() ) {
-            info.emplace_back( "DESCRIPTION", idescription->second );
+        } else if( idescription ) {
+            info.emplace_back( "DESCRIPTION", *idescription );
         } else if( has_itype_variant() ) {
             info.emplace_back( "DESCRIPTION", variant_description() );
         } else {
@@ -2555,7 +2564,7 @@ void item::debug_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
             }, enumeration_conjunction::none );
 
             info.emplace_back( "BASE", string_format( _( "flags: %s" ), flags_listed ) );
-            for( auto const &imap : item_vars ) {
+            for( auto const &imap : item_vars.as_strings() ) {
                 info.emplace_back( "BASE",
                                    string_format( _( "item var: %s, %s" ), imap.first,
                                                   imap.second ) );
@@ -5975,27 +5984,26 @@ void item::final_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
         }
     }
 
-    std::map<std::string, std::string>::const_iterator item_note = item_vars.find( "item_note" );
+    const std::optional<std::string> item_note = maybe_get_var( "item_note" );
 
-    if( item_note != item_vars.end() && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
+    if( item_note && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
         insert_separation_line( info );
         std::string ntext;
-        std::map<std::string, std::string>::const_iterator item_note_tool =
-            item_vars.find( "item_note_tool" );
+        const std::optional<std::string> item_note_tool = maybe_get_var( "item_note_tool" );
         const use_function *use_func =
-            item_note_tool != item_vars.end() ?
+            item_note_tool ?
             item_controller->find_template(
-                itype_id( item_note_tool->second ) )->get_use( "inscribe" ) :
+                itype_id( *item_note_tool ) )->get_use( "inscribe" ) :
             nullptr;
         const inscribe_actor *use_actor =
             use_func ? dynamic_cast<const inscribe_actor *>( use_func->get_actor_ptr() ) : nullptr;
         if( use_actor ) {
             //~ %1$s: gerund (e.g. carved), %2$s: item name, %3$s: inscription text
             ntext = string_format( pgettext( "carving", "%1$s on the %2$s is: %3$s" ),
-                                   use_actor->gerund, tname(), item_note->second );
+                                   use_actor->gerund, tname(), *item_note );
         } else {
             //~ %1$s: inscription text
-            ntext = string_format( pgettext( "carving", "Note: %1$s" ), item_note->second );
+            ntext = string_format( pgettext( "carving", "Note: %1$s" ), *item_note );
         }
         info.emplace_back( "DESCRIPTION", ntext );
     }
@@ -6694,6 +6702,7 @@ void item::on_pickup( Character &p )
 void item::update_inherited_flags()
 {
     inherited_tags_cache.clear();
+    cached_base_measures.reset();
 
     auto const inehrit_flags = [this]( FlagsSetType const & Flags ) {
         for( flag_id const &f : Flags ) {
@@ -6850,7 +6859,7 @@ std::string item::tname( unsigned int quantity, tname::segment_bitset const &seg
         ret += tname::print_segment( idx, *this, quantity, segments );
     }
 
-    if( item_vars.find( "item_note" ) != item_vars.end() ) {
+    if( has_var( "item_note" ) ) {
         //~ %s is an item name. This style is used to denote items with notes.
         return string_format( _( "*%s*" ), ret );
     }
@@ -7113,8 +7122,9 @@ units::mass item::weight( bool include_contents, bool integral ) const
         return 0_gram;
     }
 
+    const base_measures &base = get_base_measures();
     // Items that don't drop aren't really there, they're items just for ease of implementation
-    if( has_flag( flag_NO_DROP ) ) {
+    if( base.no_drop ) {
         return 0_gram;
     }
 
@@ -7131,18 +7141,8 @@ units::mass item::weight( bool include_contents, bool integral ) const
         return *craft_data_->cached_weight;
     }
 
-    units::mass ret;
-    double ret_mul = 1.0;
-    std::string local_str_mass = integral ? get_var( "integral_weight" ) : get_var( "weight" );
-    if( local_str_mass.empty() ) {
-        ret = integral ? type->integral_weight : type->weight;
-    } else {
-        ret = units::from_milligram( std::stoll( local_str_mass ) );
-    }
-
-    if( has_flag( flag_REDUCED_WEIGHT ) ) {
-        ret_mul *= 0.75;
-    }
+    units::mass ret = integral ? base.integral_weight : base.weight;
+    double ret_mul = base.weight_multiplier;
 
     // if this is a gun apply all of its gunmods' weight multipliers
     if( type->gun ) {
@@ -7192,7 +7192,7 @@ units::mass item::weight( bool include_contents, bool integral ) const
     }
 
     // reduce weight for sawn-off barrel capped to the apportioned weight of the barrel
-    if( gunmod_find( itype_barrel_small ) ) {
+    if( type->gun && gunmod_find( itype_barrel_small ) ) {
         const units::volume b = type->gun->barrel_volume;
         const units::mass max_barrel_weight = units::from_gram( to_milliliter( b ) );
         const units::mass barrel_weight = units::from_gram( b.value() * type->weight.value() /
@@ -7411,15 +7411,8 @@ units::volume item::volume( bool integral, bool ignore_contents, int charges_in_
         return *craft_data_->cached_volume;
     }
 
-    const int local_volume = get_var( "volume", -1 );
-    units::volume ret;
-    if( local_volume >= 0 ) {
-        ret = local_volume * units::legacy_volume_factor;
-    } else if( integral ) {
-        ret = type->integral_volume;
-    } else {
-        ret = type->volume;
-    }
+    const base_measures &base = get_base_measures();
+    units::volume ret = integral ? base.integral_volume : base.volume;
 
     if( count_by_charges() || made_of( phase_id::LIQUID ) ) {
         units::quantity<int64_t, units::volume_in_milliliter_tag> num = ret * static_cast<int64_t>
@@ -7464,6 +7457,41 @@ units::volume item::volume( bool integral, bool ignore_contents, int charges_in_
     return ret;
 }
 
+const item::base_measures &item::get_base_measures() const
+{
+    if( cached_base_measures ) {
+        return *cached_base_measures;
+    }
+    base_measures &base = cached_base_measures.emplace();
+    base.no_drop = has_flag( flag_NO_DROP );
+
+    const std::string local_str_mass = get_var( "weight" );
+    if( local_str_mass.empty() ) {
+        base.weight = type->weight;
+    } else {
+        base.weight = units::from_milligram( std::stoll( local_str_mass ) );
+    }
+    const std::string local_str_integral_mass = get_var( "integral_weight" );
+    if( local_str_integral_mass.empty() ) {
+        base.integral_weight = type->integral_weight;
+    } else {
+        base.integral_weight = units::from_milligram( std::stoll( local_str_integral_mass ) );
+    }
+    if( has_flag( flag_REDUCED_WEIGHT ) ) {
+        base.weight_multiplier *= 0.75;
+    }
+
+    const int local_volume = get_var( "volume", -1 );
+    if( local_volume >= 0 ) {
+        base.volume = local_volume * units::legacy_volume_factor;
+        base.integral_volume = base.volume;
+    } else {
+        base.volume = type->volume;
+        base.integral_volume = type->integral_volume;
+    }
+    return base;
+}
+
 int item::lift_strength() const
 {
     const int mass = units::to_gram( weight() );
@@ -7582,6 +7610,7 @@ void item::unset_flags()
 {
     item_tags.clear();
     requires_tags_processing = true;
+    cached_base_measures.reset();
 }
 
 bool item::has_fault( const fault_id &fault ) const
@@ -7634,6 +7663,7 @@ item &item::set_flag( const flag_id &flag )
         item_tags.insert( flag );
         update_prefix_suffix_flags( flag );
         requires_tags_processing = true;
+        cached_base_measures.reset();
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
     }
@@ -7672,6 +7702,7 @@ item &item::unset_flag( const flag_id &flag )
     item_tags.erase( flag );
     update_prefix_suffix_flags();
     requires_tags_processing = true;
+    cached_base_measures.reset();
     return *this;
 }
 
@@ -12651,26 +12682,27 @@ bool item_compare_by_charges( const item &left, const item &right )
 static const std::string USED_BY_IDS( "USED_BY_IDS" );
 bool item::already_used_by_player( const Character &p ) const
 {
-    const auto it = item_vars.find( USED_BY_IDS );
-    if( it == item_vars.end() ) {
+    const std::optional<std::string> used_by_ids = maybe_get_var( USED_BY_IDS );
+    if( !used_by_ids ) {
         return false;
     }
     // USED_BY_IDS always starts *and* ends with a ';', the search string
     // ';<id>;' matches at most one part of USED_BY_IDS, and only when exactly that
     // id has been added.
     const std::string needle = string_format( ";%d;", p.getID().get_value() );
-    return it->second.find( needle ) != std::string::npos;
+    return used_by_ids->find( needle ) != std::string::npos;
 }
 
 void item::mark_as_used_by_player( const Character &p )
 {
-    std::string &used_by_ids = item_vars[ USED_BY_IDS ];
+    std::string used_by_ids = get_var( USED_BY_IDS );
     if( used_by_ids.empty() ) {
         // *always* start with a ';'
         used_by_ids = ";";
     }
     // and always end with a ';'
     used_by_ids += string_format( "%d;", p.getID().get_value() );
+    set_var( USED_BY_IDS, used_by_ids );
 }
 
 bool item::can_holster( const item &obj, bool ) const
@@ -14613,7 +14645,7 @@ bool item::is_reloadable() const
 std::string item::type_name( unsigned int quantity, bool use_variant, bool use_cond_name,
                              bool use_corpse ) const
 {
-    const auto iter = item_vars.find( "name" );
+    const std::optional<std::string> name_var = maybe_get_var( "name" );
     std::string ret_name;
     if( typeId() == itype_blood ) {
         if( corpse == nullptr || corpse->id.is_null() ) {
@@ -14623,8 +14655,8 @@ std::string item::type_name( unsigned int quantity, bool use_variant, bool use_c
                                              "%s blood",  quantity ),
                                   corpse->nname() );
         }
-    } else if( iter != item_vars.end() ) {
-        return iter->second;
+    } else if( name_var ) {
+        return *name_var;
     } else if( use_variant && has_itype_variant() ) {
         ret_name = itype_variant().alt_name.translated( quantity );
     } else {
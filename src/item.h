@@ -27,6 +27,7 @@
 #include "item_contents.h"
 #include "item_location.h"
 #include "item_tname.h"
+#include "item_var_store.h"
 #include "material.h"
 #include "requirements.h"
 #include "safe_reference.h"
@@ -3123,7 +3124,7 @@ class item : public visitable
         cata::heap<FlagsSetType> prefix_tags_cache; // flags that will add prefixes to this item
         cata::heap<FlagsSetType> suffix_tags_cache; // flags that will add suffixes to this item
         lazy<safe_reference_anchor> anchor;
-        cata::heap<std::map<std::string, std::string>> item_vars;
+        item_var_store item_vars;
         const mtype *corpse = nullptr;
         std::string corpse_name;       // Name of the late lamented
         cata::heap<std::set<matec_id>> techniques; // item specific techniques
@@ -3232,6 +3233,22 @@ class item : public visitable
         int degradation_ = 0;
         light_emission light = nolight;
         mutable std::optional<float> cached_relative_encumbrance;
+
+        /**
+         * What weight() and volume() start from: the parts that only depend on the type, the item
+         * variables and the flags, before charges, gunmods and contents are added in.
+         * Reset whenever the variables or flags change.
+         */
+        struct base_measures {
+            bool no_drop = false;
+            units::mass weight = 0_gram;
+            units::mass integral_weight = 0_gram;
+            double weight_multiplier = 1.0;
+            units::volume volume = 0_ml;
+            units::volume integral_volume = 0_ml;
+        };
+        mutable std::optional<base_measures> cached_base_measures;
+        const base_measures &get_base_measures() const;
         mutable cata::value_ptr<link_data> link_;
 
         struct cat_cache {
@@ -98,6 +98,8 @@ class item_location::impl
         virtual int obtain_cost( const Character &, int ) const = 0;
         virtual void remove_item() = 0;
         virtual void on_contents_changed() = 0;
+        /** Marks whatever holds the item as changed, so that it is saved again. */
+        virtual void mark_modified() {}
         virtual void serialize( JsonOut &js ) const = 0;
         virtual item *unpack( int ) const = 0;
 
@@ -203,6 +205,10 @@ class item_location::impl::item_on_map : public item_location::impl
         item_on_map( const map_cursor &cur, item *which ) : impl( which ), cur( cur ) {}
         item_on_map( const map_cursor &cur, int idx ) : impl( idx ), cur( cur ) {}
 
+        void mark_modified() override {
+            get_map().mark_modified( cur.pos() );
+        }
+
         void serialize( JsonOut &js ) const override {
             js.start_object();
             js.member( "type", "map" );
@@ -277,6 +283,7 @@ class item_location::impl::item_on_map : public item_location::impl
 
         void on_contents_changed() override {
             target()->on_contents_changed();
+            mark_modified();
         }
 
         units::volume volume_capacity() const override {
@@ -592,6 +599,10 @@ class item_location::impl::item_in_container : public item_location::impl
             return idx;
         }
     public:
+        void mark_modified() override {
+            container.ptr->mark_modified();
+        }
+
         item_location parent_item() const override {
             return container;
         }
@@ -659,11 +670,13 @@ class item_location::impl::item_in_container : public item_location::impl
         void remove_item() override {
             container->remove_item( *target() );
             container->on_contents_changed();
+            mark_modified();
         }
 
         void on_contents_changed() override {
             target()->on_contents_changed();
             container->on_contents_changed();
+            mark_modified();
         }
 
         item_location obtain( Character &ch, const int qty ) override {
@@ -1062,6 +1075,15 @@ void item_location::on_contents_changed()
     ptr->on_contents_changed();
 }
 
+void item_location::mark_modified()
+{
+    if( !ptr->valid() ) {
+        debugmsg( "item location does not point to valid item" );
+        return;
+    }
+    ptr->mark_modified();
+}
+
 void item_location::make_active()
 {
     if( !ptr->valid() ) {
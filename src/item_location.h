@@ -96,6 +96,10 @@ class item_location
         /** Handles updates to the item location, mostly for caching. */
         void on_contents_changed();
 
+        /** Marks where the item is as changed, for callers that change the item in place.
+         *  Reading the item through a non-const location does not do this. */
+        void mark_modified();
+
         void make_active();
 
         /** Gets the selected item or nullptr */
@@ -0,0 +1,244 @@
+#include "item_var_store.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <deque>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+
+#include "json.h"
+#include "string_formatter.h"
+
+namespace
+{
+struct var_names {
+    // A deque so the views in ids stay valid while names are added
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+} // namespace
+
+static var_names &get_var_names()
+{
+    static var_names names;
+    return names;
+}
+
+static std::optional<uint32_t> find_name( const std::string_view name )
+{
+    const var_names &names = get_var_names();
+    const auto iter = names.ids.find( name );
+    if( iter == names.ids.end() ) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
+static uint32_t intern_name( const std::string_view name )
+{
+    var_names &names = get_var_names();
+    const auto iter = names.ids.find( name );
+    if( iter != names.ids.end() ) {
+        return iter->second;
+    }
+    const uint32_t id = static_cast<uint32_t>( names.names.size() );
+    names.names.emplace_back( name );
+    names.ids.emplace( names.names.back(), id );
+    return id;
+}
+
+static const std::string &name_of( const uint32_t id )
+{
+    return get_var_names().names[id];
+}
+
+// What item::set_var stored integers as
+static std::optional<int64_t> canonical_integer( const std::string &str )
+{
+    int64_t result = 0;
+    const char *last = str.data() + str.size();
+    const std::from_chars_result parsed = std::from_chars( str.data(), last, result );
+    if( parsed.ec != std::errc() || parsed.ptr != last || std::to_string( result ) != str ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// What item::set_var stored floating point numbers as, "%f" always has six decimals
+static std::optional<double> canonical_double( const std::string &str )
+{
+    const size_t dot = str.find( '.' );
+    if( dot == std::string::npos || str.size() - dot != 7 ) {
+        return std::nullopt;
+    }
+    char *end;
+    errno = 0;
+    const double result = strtod( str.c_str(), &end );
+    if( errno != 0 || end != str.data() + str.size() || string_format( "%f", result ) != str ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+static item_var_store::value from_string( const std::string &str )
+{
+    if( std::optional<int64_t> integer = canonical_integer( str ) ) {
+        return *integer;
+    }
+    if( std::optional<double> floating = canonical_double( str ) ) {
+        return *floating;
+    }
+    return str;
+}
+
+item_var_store::item_var_store( const std::map<std::string, std::string> &vars )
+{
+    entries.reserve( vars.size() );
+    for( const std::pair<const std::string, std::string> &var : vars ) {
+        entries.push_back( { intern_name( var.first ), from_string( var.second ) } );
+    }
+}
+
+const item_var_store::entry *item_var_store::find_entry( const uint32_t name ) const
+{
+    for( const entry &e : entries ) {
+        if( e.name == name ) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+const item_var_store::value *item_var_store::find( const std::string_view name ) const
+{
+    // Most items have no variables, don't bother looking the name up for them
+    if( entries.empty() ) {
+        return nullptr;
+    }
+    const std::optional<uint32_t> id = find_name( name );
+    if( !id ) {
+        return nullptr;
+    }
+    const entry *e = find_entry( *id );
+    return e == nullptr ? nullptr : &e->val;
+}
+
+void item_var_store::set( const std::string_view name, value val )
+{
+    const uint32_t id = intern_name( name );
+    for( entry &e : entries ) {
+        if( e.name == id ) {
+            e.val = std::move( val );
+            return;
+        }
+    }
+    entries.push_back( { id, std::move( val ) } );
+}
+
+void item_var_store::set_string( const std::string_view name, const std::string &val )
+{
+    set( name, from_string( val ) );
+}
+
+void item_var_store::erase( const std::string_view name )
+{
+    if( entries.empty() ) {
+        return;
+    }
+    const std::optional<uint32_t> id = find_name( name );
+    if( !id ) {
+        return;
+    }
+    entries.erase( std::remove_if( entries.begin(), entries.end(), [&id]( const entry & e ) {
+        return e.name == *id;
+    } ), entries.end() );
+}
+
+void item_var_store::erase_if( const std::function<bool( const std::string & )> &name_pred )
+{
+    entries.erase( std::remove_if( entries.begin(), entries.end(), [&name_pred]( const entry & e ) {
+        return name_pred( name_of( e.name ) );
+    } ), entries.end() );
+}
+
+void item_var_store::clear()
+{
+    entries.clear();
+}
+
+std::string item_var_store::to_string( const value &val )
+{
+    if( const std::string *str = std::get_if<std::string>( &val ) ) {
+        return *str;
+    } else if( const int64_t *integer = std::get_if<int64_t>( &val ) ) {
+        return std::to_string( *integer );
+    } else if( const double *floating = std::get_if<double>( &val ) ) {
+        return string_format( "%f", *floating );
+    }
+    const tripoint &p = std::get<tripoint>( val );
+    return string_format( "%d,%d,%d", p.x, p.y, p.z );
+}
+
+std::vector<std::pair<std::string, std::string>> item_var_store::as_strings() const
+{
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve( entries.size() );
+    for( const entry &e : entries ) {
+        result.emplace_back( name_of( e.name ), to_string( e.val ) );
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+static bool values_equal( const item_var_store::value &lhs, const item_var_store::value &rhs )
+{
+    if( lhs.index() == rhs.index() ) {
+        return lhs == rhs;
+    }
+    // Same as when all values were strings
+    return item_var_store::to_string( lhs ) == item_var_store::to_string( rhs );
+}
+
+bool item_var_store::equal_ignoring_keys( const item_var_store &rhs,
+        const std::set<std::string> &ignore_keys ) const
+{
+    if( entries.empty() && rhs.entries.empty() ) {
+        return true;
+    }
+    const auto counted = [&ignore_keys]( const entry & e ) {
+        return ignore_keys.count( name_of( e.name ) ) == 0;
+    };
+    size_t lhs_count = 0;
+    for( const entry &e : entries ) {
+        if( !counted( e ) ) {
+            continue;
+        }
+        ++lhs_count;
+        const entry *other = rhs.find_entry( e.name );
+        if( other == nullptr || !values_equal( e.val, other->val ) ) {
+            return false;
+        }
+    }
+    return lhs_count == static_cast<size_t>( std::count_if( rhs.entries.begin(), rhs.entries.end(),
+            counted ) );
+}
+
+void item_var_store::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const std::pair<std::string, std::string> &var : as_strings() ) {
+        jsout.member( var.first, var.second );
+    }
+    jsout.end_object();
+}
+
+void item_var_store::deserialize( const JsonObject &jo )
+{
+    entries.clear();
+    for( const JsonMember &member : jo ) {
+        set_string( member.name(), member.get_string() );
+    }
+}
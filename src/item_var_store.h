@@ -0,0 +1,75 @@
+#pragma once
+#ifndef CATA_SRC_ITEM_VAR_STORE_H
+#define CATA_SRC_ITEM_VAR_STORE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "point.h"
+
+class JsonObject;
+class JsonOut;
+
+/**
+ * The variables of an item, see item::set_var.
+ *
+ * Variable names are interned, a variable only holds the id of its name. Values keep the type
+ * they were set with and are only turned into strings when they are read as strings or saved.
+ * Strings that read back as the same number, like those set_var stored for numbers before and
+ * those of old saves, are kept as numbers.
+ *
+ * All variables live in one vector, which doesn't allocate while the item has none.
+ */
+class item_var_store
+{
+    public:
+        using value = std::variant<std::string, int64_t, double, tripoint>;
+
+        item_var_store() = default;
+        explicit item_var_store( const std::map<std::string, std::string> &vars );
+
+        /** Returns nullptr if there is no variable called @p name */
+        const value *find( std::string_view name ) const;
+        void set( std::string_view name, value val );
+        /** Stores @p val as a number if the number reads back as @p val */
+        void set_string( std::string_view name, const std::string &val );
+        void erase( std::string_view name );
+        void erase_if( const std::function<bool( const std::string & )> &name_pred );
+        void clear();
+
+        bool empty() const {
+            return entries.empty();
+        }
+        size_t size() const {
+            return entries.size();
+        }
+
+        /** The variables as the strings they are saved as, sorted by name */
+        std::vector<std::pair<std::string, std::string>> as_strings() const;
+        static std::string to_string( const value &val );
+
+        bool equal_ignoring_keys( const item_var_store &rhs,
+                                  const std::set<std::string> &ignore_keys ) const;
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( const JsonObject &jo );
+
+    private:
+        struct entry {
+            uint32_t name;
+            value val;
+        };
+
+        const entry *find_entry( uint32_t name ) const;
+
+        std::vector<entry> entries;
+};
+
+#endif // CATA_SRC_ITEM_VAR_STORE_H
@@ -18,6 +18,8 @@
 #include <utility>
 #include <vector>
 
+#include <flatbuffers/flexbuffers.h>
+
 #include "cached_options.h"
 #include "cata_scope_helpers.h"
 #include "cata_utility.h"
@@ -2236,6 +2238,34 @@ JsonOut::JsonOut( std::ostream &s, bool pretty, int depth ) :
     stream->setf( std::ios_base::boolalpha );
 }
 
+JsonOut::JsonOut( flexbuffers::Builder &builder ) :
+    stream( nullptr ), pretty_print( false ), builder( &builder ) {}
+
+void JsonOut::build_bool( const bool val )
+{
+    builder->Bool( val );
+}
+
+void JsonOut::build_int( const int64_t val )
+{
+    builder->Int( val );
+}
+
+void JsonOut::build_uint( const uint64_t val )
+{
+    // Parsed json stores every integer that fits as signed, and readers rely on that
+    if( val <= static_cast<uint64_t>( std::numeric_limits<int64_t>::max() ) ) {
+        builder->Int( static_cast<int64_t>( val ) );
+    } else {
+        builder->UInt( val );
+    }
+}
+
+void JsonOut::build_float( const double val )
+{
+    builder->Double( val );
+}
+
 int JsonOut::tell()
 {
     return stream->tellp();
@@ -2315,6 +2345,10 @@ void JsonOut::end_pretty()
 
 void JsonOut::start_object( bool wrap )
 {
+    if( builder != nullptr ) {
+        builder_starts.push_back( builder->StartMap() );
+        return;
+    }
     if( need_separator ) {
         write_separator();
     }
@@ -2326,6 +2360,11 @@ void JsonOut::start_object( bool wrap )
 
 void JsonOut::end_object()
 {
+    if( builder != nullptr ) {
+        builder->EndMap( builder_starts.back() );
+        builder_starts.pop_back();
+        return;
+    }
     end_pretty();
     need_wrap.pop_back();
     stream->put( '}' );
@@ -2334,6 +2373,10 @@ void JsonOut::end_object()
 
 void JsonOut::start_array( bool wrap )
 {
+    if( builder != nullptr ) {
+        builder_starts.push_back( builder->StartVector() );
+        return;
+    }
     if( need_separator ) {
         write_separator();
     }
@@ -2345,6 +2388,11 @@ void JsonOut::start_array( bool wrap )
 
 void JsonOut::end_array()
 {
+    if( builder != nullptr ) {
+        builder->EndVector( builder_starts.back(), false, false );
+        builder_starts.pop_back();
+        return;
+    }
     end_pretty();
     need_wrap.pop_back();
     stream->put( ']' );
@@ -2353,6 +2401,10 @@ void JsonOut::end_array()
 
 void JsonOut::write_null()
 {
+    if( builder != nullptr ) {
+        builder->Null();
+        return;
+    }
     if( need_separator ) {
         write_separator();
     }
@@ -2362,6 +2414,10 @@ void JsonOut::write_null()
 
 void JsonOut::write( const std::string_view val )
 {
+    if( builder != nullptr ) {
+        builder->String( val.data(), val.size() );
+        return;
+    }
     if( need_separator ) {
         write_separator();
     }
@@ -2406,6 +2462,10 @@ void JsonOut::write( const std::string_view val )
 template<size_t N>
 void JsonOut::write( const std::bitset<N> &b )
 {
+    if( builder != nullptr ) {
+        builder->String( b.to_string() );
+        return;
+    }
     if( need_separator ) {
         write_separator();
     }
@@ -2421,6 +2481,11 @@ void JsonOut::write( const std::bitset<N> &b )
 
 void JsonOut::member( const std::string_view name )
 {
+    if( builder != nullptr ) {
+        // Keys are copied with their terminator, which a string_view need not have
+        builder->Key( std::string( name ) );
+        return;
+    }
     write( name );
     write_member_separator();
 }
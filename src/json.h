@@ -42,6 +42,10 @@ class TextJsonIn;
 class TextJsonObject;
 class TextJsonValue;
 class item;
+namespace flexbuffers
+{
+class Builder;
+} // namespace flexbuffers
 
 // Traits class to distinguish sequences which are string like from others
 template< class, class = void >
@@ -731,6 +735,9 @@ class TextJsonIn
  *
  * Basic containers such as maps, sets and vectors,
  * can be serialized automatically by write() and member().
+ *
+ * A JsonOut can also be built on a flexbuffers::Builder, in which case the same calls build a
+ * FlexBuffer that reads back like the text would, without writing and parsing any text.
  */
 class JsonOut
 {
@@ -740,9 +747,20 @@ class JsonOut
         std::vector<bool> need_wrap;
         int indent_level = 0;
         bool need_separator = false;
+        // Set when building a FlexBuffer instead of writing text
+        flexbuffers::Builder *builder = nullptr;
+        // Builder stack positions of the open objects and arrays
+        std::vector<size_t> builder_starts;
+
+        void build_bool( bool val );
+        void build_int( int64_t val );
+        void build_uint( uint64_t val );
+        void build_float( double val );
 
     public:
         explicit JsonOut( std::ostream &stream, bool pretty_print = false, int depth = 0 );
+        /** Builds into @p builder. Pretty printing, tell() and seek() do not apply. */
+        explicit JsonOut( flexbuffers::Builder &builder );
         JsonOut( const JsonOut & ) = delete;
         JsonOut &operator=( const JsonOut & ) = delete;
 
@@ -774,6 +792,18 @@ class JsonOut
 
         template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
         void write( T val ) {
+            if( builder != nullptr ) {
+                if constexpr( std::is_same_v<T, bool> ) {
+                    build_bool( val );
+                } else if constexpr( std::is_floating_point_v<T> ) {
+                    build_float( val );
+                } else if constexpr( std::is_signed_v<T> ) {
+                    build_int( val );
+                } else {
+                    build_uint( val );
+                }
+                return;
+            }
             if( need_separator ) {
                 write_separator();
             }
@@ -1,6 +1,7 @@
 #include "json_loader.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <ghc/fs_std_fwd.hpp>
@@ -43,6 +44,8 @@ flexbuffer_cache &user_cache()
 }
 
 std::unordered_map<std::string, std::unique_ptr<flexbuffer_cache>> save_caches;
+// The data loader parses files on several threads at once
+std::mutex save_caches_mutex;
 
 // There's no measurable need to persist flatbuffers for save data, so just create a per-world 'cache' which parses
 // but doesn't disk-cache the parsed flatbuffer.
@@ -58,6 +61,7 @@ flexbuffer_cache &cache_for_save( const cata_path &path )
     std::string folder_or_file = path_it->u8string();
     ++path_it;
 
+    std::lock_guard<std::mutex> lock( save_caches_mutex );
     auto it = save_caches.find( worldname_str );
     if( it == save_caches.end() ) {
         it = save_caches.emplace( worldname_str,
@@ -130,6 +134,35 @@ std::optional<JsonValue> json_loader::from_path_opt( const cata_path &source_fil
     return from_path_at_offset_opt( source_file, 0 );
 }
 
+std::optional<JsonValue> json_loader::from_path_opt_uncached(
+    const cata_path &source_file ) noexcept( false )
+{
+    if( !file_exist( source_file.get_unrelative_path() ) ) {
+        return std::nullopt;
+    }
+    std::shared_ptr<parsed_flexbuffer> buffer = flexbuffer_cache::parse(
+                source_file.get_unrelative_path() );
+    if( !buffer ) {
+        return std::nullopt;
+    }
+
+    flexbuffers::Reference buffer_root = flexbuffer_root_from_storage( buffer->get_storage() );
+    return JsonValue( std::move( buffer ), buffer_root, nullptr, 0 );
+}
+
+std::optional<JsonValue> json_loader::from_binary_path_opt( const cata_path &source_file,
+        const std::string &header ) noexcept( false )
+{
+    if( !file_exist( source_file.get_unrelative_path() ) ) {
+        return std::nullopt;
+    }
+    std::shared_ptr<parsed_flexbuffer> buffer = flexbuffer_cache::map_binary(
+                source_file.get_unrelative_path(), header );
+
+    flexbuffers::Reference buffer_root = flexbuffer_root_from_storage( buffer->get_storage() );
+    return JsonValue( std::move( buffer ), buffer_root, nullptr, 0 );
+}
+
 JsonValue json_loader::from_path_at_offset( const cata_path &source_file,
         size_t offset ) noexcept( false )
 {
@@ -22,6 +22,18 @@ class json_loader
         static std::optional<JsonValue> from_path_at_offset_opt( const cata_path &source_file,
                 size_t offset = 0 ) noexcept( false );
 
+        // Like json_loader::from_path_opt, except the file is always parsed afresh and none of the
+        // shared flexbuffer caches are touched, so it is safe to call from a worker thread.
+        static std::optional<JsonValue> from_path_opt_uncached( const cata_path &source_file ) noexcept(
+            false );
+
+        // Reads a file that holds the given header followed by a FlexBuffer, see
+        // flexbuffer_cache::map_binary. The file is mapped rather than parsed, and the shared
+        // caches are not touched, so this is also safe to call from a worker thread.
+        // Returns nullopt if the file does not exist.
+        static std::optional<JsonValue> from_binary_path_opt( const cata_path &source_file,
+                const std::string &header ) noexcept( false );
+
         // Like json_loader::from_path, except instead of parsing data from a file, will parse data from a string in memory.
         static JsonValue from_string( std::string const &data ) noexcept( false );
         static std::optional<JsonValue> from_string_opt( std::string const &data ) noexcept( false );
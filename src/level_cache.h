@@ -61,7 +61,8 @@ struct level_cache {
         // stores "adjusted transparency" of the tiles
         // initial values derived from transparency_cache, uses same units
         // examples of adjustment: changed transparency on player's tile and special case for crouching
-        cata::mdarray<float, point_bub_ms> vision_transparency_cache;
+        // packed into bit planes, which is what the seen cache is cast over
+        transparency_planes vision_transparency_planes;
 
         // stores "visibility" of the tiles to the player
         // values range from 1 (fully visible to player) to 0 (not visible)
@@ -4,7 +4,6 @@
 #include <bitset>
 #include <cmath>
 #include <cstdlib>
-#include <cstring>
 #include <map>
 #include <memory>
 #include <optional>
@@ -195,10 +194,9 @@ bool map::build_transparency_cache( const int zlev )
 bool map::build_vision_transparency_cache( const int zlev )
 {
     level_cache &map_cache = get_cache( zlev );
-    auto &transparency_cache = map_cache.transparency_cache;
-    auto &vision_transparency_cache = map_cache.vision_transparency_cache;
+    transparency_planes &vision_planes = map_cache.vision_transparency_planes;
 
-    memcpy( &vision_transparency_cache, &transparency_cache, sizeof( transparency_cache ) );
+    vision_planes.build( map_cache.transparency_cache );
 
     Character &player_character = get_player_character();
     const tripoint p = player_character.pos();
@@ -220,13 +218,13 @@ bool map::build_vision_transparency_cache( const int zlev )
     for( const tripoint &loc : points_in_radius( p, 1 ) ) {
         if( loc == p ) {
             // The tile player is standing on should always be visible
-            vision_transparency_cache[p.x][p.y] = LIGHT_TRANSPARENCY_OPEN_AIR;
+            vision_planes.set( p.x, p.y, LIGHT_TRANSPARENCY_OPEN_AIR );
         } else if( ( is_crouching || is_prone || low_profile ) && coverage( loc ) >= 30 ) {
             // If we're crouching or prone behind an obstacle, we can't see past it.
-            if( vision_transparency_cache[loc.x][loc.y] != LIGHT_TRANSPARENCY_SOLID ||
+            if( vision_planes.at( loc.x, loc.y ) != LIGHT_TRANSPARENCY_SOLID ||
                 previous_move_mode != player_character.current_movement_mode() ) {
                 previous_move_mode = player_character.current_movement_mode();
-                vision_transparency_cache[loc.x][loc.y] = LIGHT_TRANSPARENCY_SOLID;
+                vision_planes.set( loc.x, loc.y, LIGHT_TRANSPARENCY_SOLID );
                 dirty = true;
             }
         }
@@ -236,9 +234,9 @@ bool map::build_vision_transparency_cache( const int zlev )
     for( const tripoint &loc : points_in_radius( p, MAX_VIEW_DISTANCE ) ) {
         if( loc == p ) {
             // The tile player is standing on should always be visible
-            vision_transparency_cache[p.x][p.y] = LIGHT_TRANSPARENCY_OPEN_AIR;
+            vision_planes.set( p.x, p.y, LIGHT_TRANSPARENCY_OPEN_AIR );
         } else if( map::ter( loc ).obj().has_flag( ter_furn_flag::TFLAG_TRANSLUCENT ) ) {
-            vision_transparency_cache[loc.x][loc.y] = LIGHT_TRANSPARENCY_SOLID;
+            vision_planes.set( loc.x, loc.y, LIGHT_TRANSPARENCY_SOLID );
             dirty = true;
         }
     }
@@ -702,7 +700,7 @@ map::apparent_light_info map::apparent_light_helper( const level_cache &map_cach
 
     auto is_opaque = [&map_cache]( const point_bub_ms & p ) {
         return map_cache.transparency_cache[p.x()][p.y()] <= LIGHT_TRANSPARENCY_SOLID &&
-               map_cache.vision_transparency_cache[p.x()][p.y()] <= LIGHT_TRANSPARENCY_SOLID;
+               map_cache.vision_transparency_planes.at( p.x(), p.y() ) <= LIGHT_TRANSPARENCY_SOLID;
     };
 
     // possibly reduce view if aiming (also blocks light)
@@ -1018,7 +1016,6 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
 {
     level_cache &map_cache = get_cache( target_z );
     using mdarray = cata::mdarray<float, point_bub_ms>;
-    mdarray &transparency_cache = map_cache.vision_transparency_cache;
     mdarray &seen_cache = map_cache.seen_cache;
     mdarray &camera_cache = map_cache.camera_cache;
     mdarray &out_cache = camera ? camera_cache : seen_cache;
@@ -1031,13 +1028,13 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
     }
 
     // Cache the caches (pointers to them)
-    array_of_grids_of<const float> transparency_caches;
+    array_of_transparency_planes vision_planes;
     array_of_grids_of<float> seen_caches;
     array_of_grids_of<const bool> floor_caches;
     vertical_direction directions_to_cast = vertical_direction::BOTH;
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         level_cache &cur_cache = get_cache( z );
-        transparency_caches[z + OVERMAP_DEPTH] = &cur_cache.vision_transparency_cache;
+        vision_planes[z + OVERMAP_DEPTH] = &cur_cache.vision_transparency_planes;
         seen_caches[z + OVERMAP_DEPTH] = camera ? &cur_cache.camera_cache : &cur_cache.seen_cache;
         floor_caches[z + OVERMAP_DEPTH] = &cur_cache.floor_cache;
         if( !cumulative ) {
@@ -1053,9 +1050,8 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
         ( *seen_caches[ target_z + OVERMAP_DEPTH ] )[origin.x()][origin.y()] = VISIBILITY_FULL;
     }
 
-    cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
-        seen_caches, transparency_caches, floor_caches, origin, penalty, 1.0,
-        directions_to_cast );
+    cast_zlight( seen_caches, vision_planes, floor_caches, origin, penalty, 1.0,
+                 directions_to_cast );
     seen_cache_process_ledges( seen_caches, floor_caches, std::nullopt );
 
     const optional_vpart_position vp = veh_at( origin );
@@ -1092,6 +1088,13 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
         }
     }
 
+    if( mirrors.empty() ) {
+        return;
+    }
+    // Mirrors cast over this level alone, with the float cache castLightAll reads
+    std::unique_ptr<mdarray> transparency_cache = std::make_unique<mdarray>();
+    map_cache.vision_transparency_planes.unpack( *transparency_cache );
+
     for( const int mirror : mirrors ) {
         const vehicle_part &vp_mirror = veh->part( mirror );
         const vpart_info &vpi_mirror = vp_mirror.info();
@@ -1120,7 +1123,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z, i
         // The naive solution of making the mirrors act like a second player
         // at an offset appears to give reasonable results though.
         castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
-            *mocache, transparency_cache, mirror_pos.xy(), offsetDistance );
+            *mocache, *transparency_cache, mirror_pos.xy(), offsetDistance );
     }
 }
 
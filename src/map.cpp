@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <climits>
 #include <cmath>
 #include <cstdlib>
@@ -81,6 +82,7 @@
 #include "overmapbuffer.h"
 #include "pathfinding.h"
 #include "pocket_type.h"
+#include "profiling.h"
 #include "projectile.h"
 #include "ranged.h"
 #include "relic.h"
@@ -92,6 +94,7 @@
 #include "sounds.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translations.h"
 #include "trap.h"
@@ -105,6 +108,7 @@
 #include "vpart_position.h"
 #include "vpart_range.h"
 #include "weather.h"
+#include "weather_type.h"
 #include "weighted_list.h"
 
 #if defined(TILES)
@@ -495,6 +499,7 @@ void map::rebuild_vehicle_level_caches()
 
 void map::add_vehicle_to_cache( vehicle *veh )
 {
+    invalidate_contents();
     if( veh == nullptr ) {
         debugmsg( "Tried to add null vehicle to cache" );
         return;
@@ -542,6 +547,7 @@ void map::clear_vehicle_level_caches( )
 
 void map::remove_vehicle_from_cache( vehicle *veh, int zmin, int zmax )
 {
+    invalidate_contents();
     for( int gridz = zmin; gridz <= zmax; gridz++ ) {
         level_cache *const ch = get_cache_lazy( gridz );
         if( ch != nullptr ) {
@@ -1853,6 +1859,7 @@ bool map::furn_set( const tripoint_bub_ms &p, const furn_id &new_furniture, cons
 
     current_submap->set_furn( l, new_target_furniture );
     current_submap->set_map_damage( point_sm_ms( l ), 0 );
+    invalidate_contents();
 
     // Set the dirty flags
     const furn_t &old_f = old_id.obj();
@@ -2390,6 +2397,7 @@ bool map::ter_set( const tripoint_bub_ms &p, const ter_id &new_terrain, bool avo
 
     current_submap->set_ter( l, new_terrain );
     current_submap->set_map_damage( point_sm_ms( l ), 0 );
+    invalidate_contents();
 
     // Set the dirty flags
     const ter_t &old_t = old_id.obj();
@@ -3788,30 +3796,33 @@ void map::decay_fields_and_scent( const time_duration &amount )
                 continue;
             }
 
-            for( int sx = 0; sx < SEEX; ++sx ) {
+            const std::bitset<SEEX *SEEY> &field_tiles = cur_submap->field_tiles();
+            for( size_t tile = 0; tile < field_tiles.size(); ++tile ) {
                 if( to_proc < 1 ) {
                     // This submap had some fields, but all got proc'd already
                     break;
                 }
+                if( !field_tiles[tile] ) {
+                    continue;
+                }
 
-                for( int sy = 0; sy < SEEY; ++sy ) {
-                    const point p( sx + smx * SEEX, sy + smy * SEEY );
+                const point_sm_ms sp = submap::field_tile_point( tile );
+                const point p( sp.x() + smx * SEEX, sp.y() + smy * SEEY );
 
-                    const field &fields = cur_submap->get_field( { sx, sy} );
-                    if( !outside_cache[p.x][p.y] ) {
-                        to_proc -= fields.field_count();
-                        continue;
-                    }
+                const field &fields = std::as_const( *cur_submap ).get_field( sp );
+                if( !outside_cache[p.x][p.y] ) {
+                    to_proc -= fields.field_count();
+                    continue;
+                }
 
-                    for( const auto &fp : fields ) {
-                        to_proc--;
-                        field_entry cur = fp.second;
-                        const field_type_id type = cur.get_field_type();
-                        const int decay_amount_factor =  type.obj().decay_amount_factor;
-                        if( decay_amount_factor != 0 ) {
-                            const time_duration decay_amount = amount / decay_amount_factor;
-                            cur.set_field_age( cur.get_field_age() + decay_amount );
-                        }
+                for( const auto &fp : fields ) {
+                    to_proc--;
+                    field_entry cur = fp.second;
+                    const field_type_id type = cur.get_field_type();
+                    const int decay_amount_factor =  type.obj().decay_amount_factor;
+                    if( decay_amount_factor != 0 ) {
+                        const time_duration decay_amount = amount / decay_amount_factor;
+                        cur.set_field_age( cur.get_field_age() + decay_amount );
                     }
                 }
             }
@@ -5354,6 +5365,7 @@ map_stack::iterator map::i_rem( const tripoint_bub_ms &p, const map_stack::const
     }
 
     current_submap->update_lum_rem( l, *it );
+    invalidate_contents();
 
     return current_submap->get_items( l ).erase( it );
 }
@@ -5372,6 +5384,18 @@ void map::i_rem( const tripoint_bub_ms &p, item *it )
     }
 }
 
+void map::mark_modified( const tripoint_bub_ms &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    invalidate_contents();
+    point_sm_ms l;
+    if( submap *const current_submap = unsafe_get_submap_at( p, l ) ) {
+        current_submap->mark_modified();
+    }
+}
+
 void map::i_clear( const tripoint &p )
 {
     i_clear( tripoint_bub_ms( p ) );
@@ -5387,6 +5411,7 @@ void map::i_clear( const tripoint_bub_ms &p )
     }
 
     current_submap->set_lum( l, 0 );
+    invalidate_contents();
     current_submap->get_items( l ).clear();
 }
 
@@ -5527,6 +5552,7 @@ item &map::add_item_or_charges( const tripoint_bub_ms &pos, item obj, bool overf
 std::pair<item *, tripoint_bub_ms> map::_add_item_or_charges( const tripoint_bub_ms &pos, item obj,
         int &copies_remaining, bool overflow )
 {
+    invalidate_contents();
     // Checks if item would not be destroyed if added to this tile
     auto valid_tile = [&]( const tripoint_bub_ms & e ) {
         if( !inbounds( e ) ) {
@@ -5734,6 +5760,7 @@ item &map::add_item( const tripoint_bub_ms &p, item new_item, int copies )
     invalidate_max_populated_zlev( p.z() );
 
     current_submap->update_lum_add( l, new_item );
+    invalidate_contents();
 
     const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
     while( --copies > 0 ) {
@@ -5944,6 +5971,7 @@ static void process_vehicle_items( vehicle &cur_veh, int part )
 
 void map::process_items()
 {
+    profiling::scoped_zone profile( profiling::zone::process_items );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z();
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z();
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -5994,6 +6022,10 @@ void map::process_items_in_submap( submap &current_submap, const tripoint_rel_sm
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
     std::vector<item_reference> active_items = current_submap.active_items.get_for_processing();
+    if( !active_items.empty() ) {
+        // Active items are changed in place through the cache
+        current_submap.mark_modified();
+    }
     const point_bub_ms grid_offset( gridp.x() * SEEX, gridp.y() * SEEY );
     for( item_reference &active_item_ref : active_items ) {
         if( !active_item_ref.item_ref ) {
@@ -6235,6 +6267,7 @@ std::list<item> use_amount_stack( Stack stack, const itype_id &type, int &quanti
 std::list<item> map::use_amount_square( const tripoint_bub_ms &p, const itype_id &type,
                                         int &quantity, const std::function<bool( const item & )> &filter )
 {
+    invalidate_contents();
     std::list<item> ret;
     // Handle infinite map sources.
     item water = liquid_from( p );
@@ -6281,6 +6314,7 @@ std::list<item_location> map::items_with( const tripoint_bub_ms &p,
 std::list<item> map::use_amount( const std::vector<tripoint> &reachable_pts, const itype_id &type,
                                  int &quantity, const std::function<bool( const item & )> &filter, bool select_ind )
 {
+    invalidate_contents();
     std::vector<tripoint_bub_ms> temp;
     temp.reserve( reachable_pts.size() );
 
@@ -6428,6 +6462,7 @@ std::list<item> map::use_charges( const std::vector<tripoint_bub_ms> &reachable_
                                   const std::function<bool( const item & )> &filter,
                                   basecamp *bcp, bool in_tools )
 {
+    invalidate_contents();
     std::list<item> ret;
 
     // We prefer infinite map sources where available, so search for those
@@ -6623,6 +6658,8 @@ partial_con *map::partial_con_at( const tripoint_bub_ms &p )
     }
     auto it = current_submap->partial_constructions.find( tripoint_sm_ms( l, p.z() ) );
     if( it != current_submap->partial_constructions.end() ) {
+        // The caller may advance the construction
+        current_submap->mark_modified();
         return &it->second;
     }
     return nullptr;
@@ -6640,6 +6677,7 @@ void map::partial_con_remove( const tripoint_bub_ms &p )
         return;
     }
     current_submap->partial_constructions.erase( tripoint_sm_ms( l, p.z() ) );
+    current_submap->mark_modified();
     memory_cache_dec_set_dirty( p, true );
     avatar &player_character = get_avatar();
     if( player_character.sees( p ) ) {
@@ -6658,6 +6696,7 @@ void map::partial_con_set( const tripoint_bub_ms &p, const partial_con &con )
         debugmsg( "Tried to set construction at %s but the submap is not loaded", l.to_string() );
         return;
     }
+    current_submap->mark_modified();
     if( !current_submap->partial_constructions.emplace( tripoint_sm_ms( l, p.z() ), con ).second ) {
         debugmsg( "set partial con on top of terrain which already has a partial con" );
     }
@@ -6954,6 +6993,7 @@ bool map::add_field( const tripoint_bub_ms &p, const field_type_id &type_id, int
     if( !type_id ) {
         return false;
     }
+    invalidate_contents();
 
     // Don't spawn non-gaseous fields on open air
     if( has_flag( ter_furn_flag::TFLAG_NO_FLOOR, p ) && type_id.obj().phase != phase_id::GAS ) {
@@ -7793,21 +7833,6 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
     return sees( F.raw(), T.raw(), range, dummy, with_fields );
 }
 
-// TODO: Change this to a hash function on the map implementation. This will also allow us to
-// account for the complete lack of entropy in the top 16 bits.
-point map::sees_cache_key( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const
-{
-    // Canonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint_bub_ms &min = from < to ? from : to;
-    const tripoint_bub_ms &max = !( from < to ) ? from : to;
-
-    // A little gross, just pack the values into an integer.
-    return point(
-               min.x() << 20 | min.y() << 10 | ( min.z() + OVERMAP_DEPTH ),
-               max.x() << 20 | max.y() << 10 | ( max.z() + OVERMAP_DEPTH )
-           );
-}
-
 /**
  * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
  **/
@@ -7822,16 +7847,14 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
 {
     bool ( map:: * f_transparent )( const tripoint & p ) const =
         with_fields ? &map::is_transparent : &map::is_transparent_wo_fields;
-    lru_cache_t &skew_cache = with_fields ? skew_vision_cache : skew_vision_wo_fields_cache;
     if( std::abs( F.z() - T.z() ) > fov_3d_z_range ||
         ( range >= 0 && range < rl_dist( F, T ) ) ||
         !inbounds( T ) ) {
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    const point key = sees_cache_key( F, T );
-    if( allow_cached ) {
-        char cached = skew_cache.get( key, -1 );
+    if( allow_cached && !sight_caches_frozen ) {
+        const int cached = sight_results.get( F, T, with_fields );
         if( cached != -1 ) {
             return cached > 0;
         }
@@ -7852,7 +7875,9 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
             }
             return true;
         } );
-        skew_cache.insert( 100000, key, visible ? 1 : 0 );
+        if( !sight_caches_frozen ) {
+            sight_results.insert( F, T, with_fields, visible );
+        }
         return visible;
     }
 
@@ -7885,7 +7910,9 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
         last_point = new_point;
         return true;
     } );
-    skew_cache.insert( 100000, key, visible ? 1 : 0 );
+    if( !sight_caches_frozen ) {
+        sight_results.insert( F, T, with_fields, visible );
+    }
     return visible;
 }
 
@@ -8491,6 +8518,7 @@ shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const poin
 
 void map::shift( const point_rel_sm &sp )
 {
+    invalidate_contents();
     if( !zlevels ) {
         debugmsg( "map::shift called from map that doesn't support Z levels" );
         return;
@@ -8699,6 +8727,7 @@ bool generate_uniform_omt( const tripoint_abs_sm &p, const oter_id &terrain_type
 
 void map::loadn( const point &grid, bool update_vehicles )
 {
+    invalidate_contents();
     dbg( D_INFO ) << "map::loadn(game[" << g.get() << "], worldx[" << abs_sub.x()
                   << "], worldy[" << abs_sub.y() << "], grid " << grid << ")";
 
@@ -9533,7 +9562,10 @@ void map::spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight, b
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->mark_modified();
+        current_submap->spawns.clear();
+    }
 }
 
 void map::spawn_monsters( bool ignore_sight, bool spawn_nonlocal )
@@ -9556,6 +9588,7 @@ void map::spawn_monsters( bool ignore_sight, bool spawn_nonlocal )
 void map::clear_spawns()
 {
     for( submap *&smap : grid ) {
+        smap->mark_modified();
         smap->spawns.clear();
     }
 }
@@ -10124,19 +10157,67 @@ void map::do_vehicle_caching( int z )
     }
 }
 
-void map::build_map_cache( const int zlev, bool skip_lightmap )
+bool map::build_level_caches( const int minz, const int maxz )
 {
-    const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
-    const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
+    const auto build_level = [this]( const int z, const bool outside ) {
+        if( outside ) {
+            build_outside_cache( z );
+        }
+        build_transparency_cache( z );
+        return build_floor_cache( z );
+    };
+
+    bool parallel = zlevels && minz < maxz && worker_threads_enabled();
+    // Workers must not report errors themselves, so leave missing submaps to the serial path.
+    for( int z = minz; parallel && z <= maxz; z++ ) {
+        for( int smx = 0; parallel && smx < my_MAPSIZE; ++smx ) {
+            for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+                if( get_submap_at_grid( tripoint_rel_sm{ smx, smy, z } ) == nullptr ) {
+                    parallel = false;
+                    break;
+                }
+            }
+        }
+    }
+
     bool seen_cache_dirty = false;
-    bool camera_cache_dirty = false;
+    if( !parallel ) {
+        for( int z = minz; z <= maxz; z++ ) {
+            // The outside cache is skipped on a level whose cache does not exist yet,
+            // build_transparency_cache is what creates it.
+            seen_cache_dirty |= build_level( z, get_cache_lazy( z ) != nullptr );
+            seen_cache_dirty |= get_cache( z ).seen_cache_dirty;
+        }
+        return seen_cache_dirty;
+    }
+
+    // get_cache creates missing caches, which must not happen concurrently.
+    // Resolving the weather id caches its index, so do that here as well.
+    get_weather().weather_id.obj();
+    std::array<bool, OVERMAP_LAYERS> had_cache;
     for( int z = minz; z <= maxz; z++ ) {
-        build_outside_cache( z );
-        build_transparency_cache( z );
-        bool floor_cache_was_dirty = build_floor_cache( z );
-        seen_cache_dirty |= floor_cache_was_dirty;
+        had_cache[z + OVERMAP_DEPTH] = get_cache_lazy( z ) != nullptr;
+        get_cache( z );
+    }
+    std::array<bool, OVERMAP_LAYERS> floor_dirty{};
+    get_thread_pool().parallel_for( static_cast<size_t>( maxz - minz + 1 ), [&]( const size_t i ) {
+        const int z = minz + static_cast<int>( i );
+        floor_dirty[z + OVERMAP_DEPTH] = build_level( z, had_cache[z + OVERMAP_DEPTH] );
+    } );
+    for( int z = minz; z <= maxz; z++ ) {
+        seen_cache_dirty |= floor_dirty[z + OVERMAP_DEPTH];
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty;
     }
+    return seen_cache_dirty;
+}
+
+void map::build_map_cache( const int zlev, bool skip_lightmap )
+{
+    profiling::scoped_zone profile( profiling::zone::build_map_cache );
+    const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
+    const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
+    bool seen_cache_dirty = build_level_caches( minz, maxz );
+    bool camera_cache_dirty = false;
     // needs a separate pass as it changes the caches on neighbour z-levels (e.g. floor_cache);
     // otherwise such changes might be overwritten by main cache-building logic
     for( int z = minz; z <= maxz; z++ ) {
@@ -10147,8 +10228,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     }
 
     if( seen_cache_dirty ) {
-        skew_vision_cache.clear();
-        skew_vision_wo_fields_cache.clear();
+        sight_results.invalidate();
     }
     avatar &u = get_avatar();
     Character::moncam_cache_t mcache = u.get_active_moncams();
@@ -10887,6 +10967,7 @@ const level_cache &map::access_cache( int zlev ) const
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    abstract.dirty.set();
 }
 
 pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
@@ -10897,14 +10978,18 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+        pathfinding_cache &cache = get_pathfinding_cache( zlev );
+        cache.dirty = true;
+        cache.abstract.dirty.set();
     }
 }
 
 void map::set_pathfinding_cache_dirty( const tripoint_bub_ms &p )
 {
     if( inbounds( p ) ) {
-        get_pathfinding_cache( p.z() ).dirty_points.insert( p.xy().raw() );
+        pathfinding_cache &cache = get_pathfinding_cache( p.z() );
+        cache.dirty_points.insert( p.xy().raw() );
+        cache.abstract.dirty.set( ( p.x() / SEEX ) * MAPSIZE + p.y() / SEEY );
     }
 }
 
@@ -11139,8 +11224,7 @@ void map::invalidate_max_populated_zlev( int zlev )
 
 bool map::has_potential_los( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const
 {
-    const point key = sees_cache_key( from, to );
-    char cached = skew_vision_cache.get( key, -1 );
+    const int cached = sight_results.get( from, to, true );
     if( cached != -1 ) {
         return cached > 0;
     }
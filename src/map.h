@@ -35,13 +35,13 @@
 #include "level_cache.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "map_iterator.h"
 #include "map_selector.h"
 #include "mapdata.h"
 #include "maptile_fwd.h"
 #include "point.h"
 #include "rng.h"
+#include "sight_cache.h"
 #include "type_id.h"
 #include "units.h"
 #include "value_ptr.h"
@@ -97,6 +97,7 @@ class map;
 
 enum class ter_furn_flag : int;
 struct pathfinding_cache;
+struct pathfinding_corridor;
 struct pathfinding_settings;
 template<typename T>
 struct weighted_int_list;
@@ -686,6 +687,18 @@ class map
         bool sees( const tripoint &F, const tripoint &T, int range, bool with_fields = true ) const;
         bool sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int range,
                    bool with_fields = true ) const;
+        /**
+         * While frozen, sees() neither looks up nor remembers its results in the cache of recent
+         * checks, so that it can be called from several threads at once. The caches of all
+         * z-levels involved must exist and nothing may change the map meanwhile.
+         */
+        void freeze_sight_caches( bool frozen ) {
+            sight_caches_frozen = frozen;
+        }
+        /** How well the cache of recent sight checks has been doing since the map was created. */
+        const sight_cache_stats &get_sight_cache_stats() const {
+            return sight_results.stats();
+        }
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -702,7 +715,6 @@ class map
                    bool with_fields = true ) const;
         bool sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int range, int &bresenham_slope,
                    bool with_fields = true, bool allow_cached = true ) const;
-        point sees_cache_key( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const;
     public:
         /**
         * Returns coverage of target in relation to the observer. Target is loc2, observer is loc1.
@@ -825,6 +837,20 @@ class map
         int extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
                         const pathfinding_settings &settings,
                         PathfindingFlags p_special ) const;
+        // A* search from f to t, restricted to a padded box around both points and, if given,
+        // to the submaps of |corridor|. Stores the cost of the found path in |cost|. Returns an
+        // empty vector if there is no path or if it would be longer than |max_length|.
+        std::vector<tripoint> route_search( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings, int max_length,
+                                            const std::function<bool( const tripoint & )> &avoid, int &cost,
+                                            pathfinding_corridor *corridor ) const;
+        // Plans the route over submaps first, using the abstract graph of the pathfinding cache,
+        // and then searches for it only in the submaps along that plan and around them.
+        // Returns an empty vector if that fails or if the unrestricted search could have found
+        // a cheaper route, the caller then has to do the unrestricted search.
+        std::vector<tripoint> route_hierarchical( const tripoint &f, const tripoint &t,
+                const pathfinding_settings &settings,
+                const std::function<bool( const tripoint & )> &avoid ) const;
     public:
 
         // Vehicles: Common to 2D and 3D
@@ -1503,6 +1529,21 @@ class map
         // TODO: Get rid of untyped overload.
         item liquid_from( const tripoint &p );
         item liquid_from( const tripoint_bub_ms &p ) const;
+        /**
+         * Changes whenever items, terrain, furniture, fields or vehicles on the map change, so that
+         * inventories formed from it (see @ref inventory::form_from_map) know to be rebuilt.
+         */
+        unsigned int get_contents_generation() const {
+            return contents_generation;
+        }
+        void invalidate_contents() {
+            ++contents_generation;
+        }
+        /**
+         * Marks the submap containing @p p as changed, for code that changes things on it without
+         * going through the map, such as through an item_location.
+         */
+        void mark_modified( const tripoint_bub_ms &p );
         // TODO: Get rid of untyped overload.
         void i_clear( const tripoint &p );
         void i_clear( const tripoint_bub_ms &p );
@@ -2317,6 +2358,10 @@ class map
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
         bool build_transparency_cache( int zlev );
+        // Builds the outside, transparency and floor caches of every level in [minz, maxz].
+        // These only read submaps and write their own level_cache, so with worker threads
+        // enabled the levels are built concurrently. Returns true if the seen cache is dirty.
+        bool build_level_caches( int minz, int maxz );
         bool build_vision_transparency_cache( int zlev );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -2605,12 +2650,13 @@ class map
         std::set<tripoint_abs_sm> submaps_with_active_items;
         std::set<tripoint_abs_sm> submaps_with_active_items_dirty;
 
+        unsigned int contents_generation = 0;
+
         /**
          * Cache of coordinate pairs recently checked for visibility.
          */
-        using lru_cache_t = lru_cache<point, char>;
-        mutable lru_cache_t skew_vision_cache;
-        mutable lru_cache_t skew_vision_wo_fields_cache;
+        mutable sight_cache sight_results;
+        bool sight_caches_frozen = false;
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
@@ -56,6 +56,7 @@
 #include "npc.h"
 #include "overmapbuffer.h"
 #include "point.h"
+#include "profiling.h"
 #include "rng.h"
 #include "scent_block.h"
 #include "scent_map.h"
@@ -170,6 +171,7 @@ int map::burn_body_part( Character &you, field_entry &cur, const bodypart_id &bp
 
 void map::process_fields()
 {
+    profiling::scoped_zone profile( profiling::zone::process_fields );
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         auto &field_cache = get_cache( z ).field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
@@ -465,7 +467,7 @@ struct field_proc_data {
 
 /*
 Function: process_fields_in_submap
-Iterates over every field on every tile of the given submap given as parameter.
+Iterates over every field on every tile of the given submap that may have a field.
 This is the general update function for field effects. This should only be called once per game turn.
 If you need to insert a new field behavior per unit time add a case statement in the switch below.
 */
@@ -478,8 +480,6 @@ void map::process_fields_in_submap( submap *const current_submap,
 
     // Initialize the map tile wrapper
     maptile map_tile( current_submap, point_sm_ms_zero );
-    int &locx = map_tile.pos_.x();
-    int &locy = map_tile.pos_.y();
     const point sm_offset = sm_to_ms_copy( submap.xy() );
 
     field_proc_data pd{
@@ -492,58 +492,66 @@ void map::process_fields_in_submap( submap *const current_submap,
         &( *fd_null )
     };
 
-    // Loop through all tiles in this submap indicated by current_submap
-    for( locx = 0; locx < SEEX; locx++ ) {
-        for( locy = 0; locy < SEEY; locy++ ) {
-            // Get a reference to the field variable from the submap;
-            // contains all the pointers to the real field effects.
-            field &curfield = current_submap->get_field( {static_cast<int>( locx ), static_cast<int>( locy )} );
-
-            // when displayed_field_type == fd_null it means that `curfield` has no fields inside
-            // avoids instantiating (relatively) expensive map iterator
-            if( !curfield.displayed_field_type() ) {
-                continue;
-            }
+    // Loop through the tiles of this submap that may have fields, in the order of a scan over
+    // x and then y. Fields spread into tiles further along are processed in this pass as well.
+    const std::bitset<SEEX *SEEY> &field_tiles = current_submap->field_tiles();
+    for( size_t tile = 0; tile < field_tiles.size(); ++tile ) {
+        if( !field_tiles[tile] ) {
+            continue;
+        }
+        map_tile.pos_ = submap::field_tile_point( tile );
+        // Get a reference to the field variable from the submap;
+        // contains all the pointers to the real field effects.
+        field &curfield = current_submap->get_field( map_tile.pos_ );
 
-            // This is a translation from local coordinates to submap coordinates.
-            const tripoint_sm_ms p = tripoint_sm_ms( map_tile.pos() + sm_offset, submap.z );
+        // when displayed_field_type == fd_null it means that `curfield` has no fields inside
+        // avoids instantiating (relatively) expensive map iterator
+        if( !curfield.displayed_field_type() ) {
+            current_submap->clear_field_tile( map_tile.pos_ );
+            continue;
+        }
 
-            for( auto it = curfield.begin(); it != curfield.end(); ) {
-                // Iterating through all field effects in the submap's field.
-                field_entry &cur = it->second;
-                const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
+        // This is a translation from local coordinates to submap coordinates.
+        const tripoint_sm_ms p = tripoint_sm_ms( map_tile.pos() + sm_offset, submap.z );
 
-                pd.cur_fd_type_id = cur.get_field_type();
-                pd.cur_fd_type = &( *pd.cur_fd_type_id );
+        for( auto it = curfield.begin(); it != curfield.end(); ) {
+            // Iterating through all field effects in the submap's field.
+            field_entry &cur = it->second;
+            const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
 
-                // The field might have been killed by processing a neighbor field
-                if( prev_intensity == 0 ) {
-                    on_field_modified( p.raw(), *pd.cur_fd_type );
-                    --current_submap->field_count;
-                    curfield.remove_field( it++ );
-                    continue;
-                }
+            pd.cur_fd_type_id = cur.get_field_type();
+            pd.cur_fd_type = &( *pd.cur_fd_type_id );
 
-                // Don't process "newborn" fields. This gives the player time to run if they need to.
-                if( cur.get_field_age() == 0_turns ) {
-                    cur.do_decay();
-                    if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
-                        on_field_modified( p.raw(), *pd.cur_fd_type );
-                    }
-                    it++;
-                    continue;
-                }
-
-                for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
-                    proc( p.raw(), cur, pd );
-                }
+            // The field might have been killed by processing a neighbor field
+            if( prev_intensity == 0 ) {
+                on_field_modified( p.raw(), *pd.cur_fd_type );
+                --current_submap->field_count;
+                curfield.remove_field( it++ );
+                continue;
+            }
 
+            // Don't process "newborn" fields. This gives the player time to run if they need to.
+            if( cur.get_field_age() == 0_turns ) {
                 cur.do_decay();
                 if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
                     on_field_modified( p.raw(), *pd.cur_fd_type );
                 }
                 it++;
+                continue;
             }
+
+            for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
+                proc( p.raw(), cur, pd );
+            }
+
+            cur.do_decay();
+            if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
+                on_field_modified( p.raw(), *pd.cur_fd_type );
+            }
+            it++;
+        }
+        if( !curfield.displayed_field_type() ) {
+            current_submap->clear_field_tile( map_tile.pos_ );
         }
     }
     sblk.commit_modifications();
@@ -1,26 +1,37 @@
 #include "mapbuffer.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <flatbuffers/flexbuffers.h>
+
+#include "calendar.h"
 #include "cata_utility.h"
 #include "debug.h"
 #include "filesystem.h"
 #include "input.h"
 #include "json.h"
+#include "json_loader.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
 #include "popup.h"
+#include "save_writer.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "ui_manager.h"
 
@@ -45,36 +56,254 @@ static cata_path find_dirname( const tripoint_abs_omt &om_addr )
             segment_addr.y(), segment_addr.z() );
 }
 
+// Binary quads are this header followed by the FlexBuffer encoding of the json document that
+// would be in the text quad file. Change the version digits when the encoding changes.
+static const std::string binary_quad_header( "CDDA-QUAD-FB-v01" );
+
+static cata_path find_binary_quad_path( const cata_path &dirname, const tripoint_abs_omt &om_addr )
+{
+    return dirname / string_format( "%d.%d.%d.mapb", om_addr.x(), om_addr.y(), om_addr.z() );
+}
+
+// Returns the path of the quad file in dirname: the binary quad if there is one, else the text
+// quad, or its legacy equivalent if only that exists.
+// Only touches the file system, so this may be called from a worker thread.
+static cata_path resolve_quad_path( const cata_path &dirname, const tripoint_abs_omt &om_addr )
+{
+    cata_path binary_quad_path = find_binary_quad_path( dirname, om_addr );
+    cata_path quad_path = find_quad_path( dirname, om_addr );
+    // Either may still be waiting to be written by the last autosave
+    get_save_writer().wait_for( binary_quad_path.get_unrelative_path() );
+    get_save_writer().wait_for( quad_path.get_unrelative_path() );
+    if( file_exist( binary_quad_path ) ) {
+        return binary_quad_path;
+    }
+
+    if( !file_exist( quad_path ) ) {
+        // Fix for old saves where the path was generated using std::stringstream, which
+        // did format the number using the current locale. That formatting may insert
+        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+        // of "map/1234.7.8.map".
+        std::ostringstream buffer;
+        buffer << om_addr.x() << "." << om_addr.y() << "." << om_addr.z()
+               << ".map";
+        cata_path legacy_quad_path = dirname / buffer.str();
+        if( file_exist( legacy_quad_path ) ) {
+            quad_path = std::move( legacy_quad_path );
+        }
+    }
+    return quad_path;
+}
+
+// Reads the quad file at quad_path in whichever format it is in.
+// Does not touch any shared state, so this may be called from a worker thread.
+static std::optional<JsonValue> read_quad( const cata_path &quad_path )
+{
+    if( quad_path.get_unrelative_path().extension() == ".mapb" ) {
+        return json_loader::from_binary_path_opt( quad_path, binary_quad_header );
+    }
+    return json_loader::from_path_opt_uncached( quad_path );
+}
+
+struct mapbuffer::staged_quad {
+    cata_path path;
+    bool done = false;
+    // Empty if the quad has never been saved
+    std::optional<JsonValue> json;
+    // Set instead of json if reading or parsing failed
+    std::string error;
+};
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
-mapbuffer::~mapbuffer() = default;
+
+mapbuffer::~mapbuffer()
+{
+    // The workers still refer to this instance, don't leave them dangling.
+    std::unique_lock<std::mutex> lock( prefetch_mutex );
+    prefetch_done.wait( lock, [this] {
+        return prefetches_running == 0;
+    } );
+}
+
+// The submaps of a quad in the order they are saved in
+static const std::array<point, 4> quad_offsets = { {
+        point_zero, point_south, point_east, point_south_east
+    }
+};
+
+bool mapbuffer::buffered_quad::empty() const
+{
+    return std::all_of( submaps.begin(), submaps.end(), []( const std::unique_ptr<submap> &sm ) {
+        return sm == nullptr;
+    } );
+}
+
+size_t mapbuffer::quad_table::slot_of( const tripoint_abs_omt &pos ) const
+{
+    uint64_t key = static_cast<uint32_t>( pos.x() );
+    key = key * 1099511628211ULL ^ static_cast<uint32_t>( pos.y() );
+    key = key * 1099511628211ULL ^ static_cast<uint32_t>( pos.z() );
+    // Fibonacci hashing, so that neighboring quads spread over the whole table
+    return ( key * 11400714819323198485ULL ) >> ( 64 - slot_bits );
+}
+
+mapbuffer::buffered_quad *mapbuffer::quad_table::find( const tripoint_abs_omt &pos ) const
+{
+    if( slots.empty() ) {
+        return nullptr;
+    }
+    const size_t mask = slots.size() - 1;
+    for( size_t i = slot_of( pos ); slots[i]; i = ( i + 1 ) & mask ) {
+        if( slots[i]->pos == pos ) {
+            return slots[i].get();
+        }
+    }
+    return nullptr;
+}
+
+mapbuffer::buffered_quad &mapbuffer::quad_table::find_or_insert( const tripoint_abs_omt &pos )
+{
+    if( buffered_quad *existing = find( pos ) ) {
+        return *existing;
+    }
+    // Keep at least half of the slots free, so that the probe sequences stay short
+    if( ( count + 1 ) * 2 > slots.size() ) {
+        grow();
+    }
+    const size_t mask = slots.size() - 1;
+    size_t i = slot_of( pos );
+    while( slots[i] ) {
+        i = ( i + 1 ) & mask;
+    }
+    slots[i] = std::make_unique<buffered_quad>();
+    slots[i]->pos = pos;
+    ++count;
+    return *slots[i];
+}
+
+void mapbuffer::quad_table::erase( const tripoint_abs_omt &pos )
+{
+    if( slots.empty() ) {
+        return;
+    }
+    const size_t mask = slots.size() - 1;
+    size_t hole = slot_of( pos );
+    while( slots[hole] && slots[hole]->pos != pos ) {
+        hole = ( hole + 1 ) & mask;
+    }
+    if( !slots[hole] ) {
+        return;
+    }
+    slots[hole].reset();
+    --count;
+    // Move later entries of the probe sequence back into the hole, so that lookups do not
+    // stop early at it.
+    for( size_t i = ( hole + 1 ) & mask; slots[i]; i = ( i + 1 ) & mask ) {
+        const size_t home = slot_of( slots[i]->pos );
+        const bool stays = hole <= i ? hole < home && home <= i : hole < home || home <= i;
+        if( !stays ) {
+            slots[hole] = std::move( slots[i] );
+            hole = i;
+        }
+    }
+}
+
+void mapbuffer::quad_table::clear()
+{
+    slots.clear();
+    slot_bits = 0;
+    count = 0;
+}
+
+std::vector<tripoint_abs_omt> mapbuffer::quad_table::positions() const
+{
+    std::vector<tripoint_abs_omt> result;
+    result.reserve( count );
+    for( const std::unique_ptr<buffered_quad> &q : slots ) {
+        if( q ) {
+            result.push_back( q->pos );
+        }
+    }
+    return result;
+}
+
+void mapbuffer::quad_table::grow()
+{
+    std::vector<std::unique_ptr<buffered_quad>> old_slots = std::move( slots );
+    slot_bits = std::max( slot_bits + 1, 10 );
+    slots = std::vector<std::unique_ptr<buffered_quad>>( size_t( 1 ) << slot_bits );
+    const size_t mask = slots.size() - 1;
+    for( std::unique_ptr<buffered_quad> &q : old_slots ) {
+        if( q ) {
+            size_t i = slot_of( q->pos );
+            while( slots[i] ) {
+                i = ( i + 1 ) & mask;
+            }
+            slots[i] = std::move( q );
+        }
+    }
+}
+
+std::unique_ptr<submap> &mapbuffer::quad_slot( buffered_quad &q, const tripoint_abs_sm &p )
+{
+    const tripoint_abs_sm corner = project_to<coords::sm>( q.pos );
+    return q.submaps[( p.x() - corner.x() ) + 2 * ( p.y() - corner.y() )];
+}
+
+submap *mapbuffer::find_submap( const tripoint_abs_sm &p ) const
+{
+    buffered_quad *q = held_quads.find( project_to<coords::omt>( p ) );
+    return q ? quad_slot( *q, p ).get() : nullptr;
+}
 
 void mapbuffer::clear()
 {
-    submaps.clear();
+    held_quads.clear();
+    std::lock_guard<std::mutex> lock( prefetch_mutex );
+    staged.clear();
 }
 
 void mapbuffer::clear_outside_reality_bubble()
 {
     map &here = get_map();
-    auto it = submaps.begin();
-    while( it != submaps.end() ) {
-        if( here.inbounds( it->first ) ) {
-            ++it;
-        } else {
-            it = submaps.erase( it );
+    for( const tripoint_abs_omt &pos : held_quads.positions() ) {
+        buffered_quad &q = *held_quads.find( pos );
+        for( const point &offset : quad_offsets ) {
+            const tripoint_abs_sm p = project_to<coords::sm>( pos ) + offset;
+            if( !here.inbounds( p ) ) {
+                quad_slot( q, p ).reset();
+            }
+        }
+        if( q.empty() ) {
+            held_quads.erase( pos );
+        }
+    }
+}
+
+submap_item_stats mapbuffer::item_stats() const
+{
+    submap_item_stats stats;
+    for( const tripoint_abs_omt &pos : held_quads.positions() ) {
+        for( const std::unique_ptr<submap> &sm : held_quads.find( pos )->submaps ) {
+            if( sm ) {
+                stats += sm->item_stats();
+            }
         }
     }
+    return stats;
 }
 
 bool mapbuffer::add_submap( const tripoint_abs_sm &p, std::unique_ptr<submap> &sm )
 {
-    if( submaps.count( p ) ) {
+    std::unique_ptr<submap> &slot = quad_slot( held_quads.find_or_insert( project_to<coords::omt>
+                                    ( p ) ), p );
+    if( slot ) {
         return false;
     }
 
-    submaps[p] = std::move( sm );
+    slot = std::move( sm );
 
     return true;
 }
@@ -93,12 +322,16 @@ bool mapbuffer::add_submap( const tripoint_abs_sm &p, submap *sm )
 
 void mapbuffer::remove_submap( const tripoint_abs_sm &addr )
 {
-    auto m_target = submaps.find( addr );
-    if( m_target == submaps.end() ) {
+    const tripoint_abs_omt om_addr = project_to<coords::omt>( addr );
+    buffered_quad *q = held_quads.find( om_addr );
+    if( q == nullptr || !quad_slot( *q, addr ) ) {
         debugmsg( "Tried to remove non-existing submap %s", addr.to_string() );
         return;
     }
-    submaps.erase( m_target );
+    quad_slot( *q, addr ).reset();
+    if( q->empty() ) {
+        held_quads.erase( om_addr );
+    }
 }
 
 submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
@@ -106,8 +339,9 @@ submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
     dbg( D_INFO ) << "mapbuffer::lookup_submap( x[" << p.x() << "], y[" << p.y() << "], z["
                   << p.z() << "])";
 
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
+    buffered_quad *q = held_quads.find( project_to<coords::omt>( p ) );
+    submap *sm = q ? quad_slot( *q, p ).get() : nullptr;
+    if( sm == nullptr ) {
         try {
             return unserialize_submaps( p );
         } catch( const std::exception &err ) {
@@ -116,13 +350,13 @@ submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
         return nullptr;
     }
 
-    return iter->second.get();
+    q->last_used = ++use_clock;
+    return sm;
 }
 
 bool mapbuffer::submap_exists( const tripoint_abs_sm &p )
 {
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
+    if( find_submap( p ) == nullptr ) {
         try {
             return unserialize_submaps( p );
         } catch( const std::exception &err ) {
@@ -139,19 +373,18 @@ void mapbuffer::save( bool delete_after_save )
     assure_dir_exist( PATH_INFO::world_base_save_path() + "/maps" );
 
     int num_saved_submaps = 0;
-    int num_total_submaps = submaps.size();
+    int num_total_submaps = held_quads.size() * 4;
+    last_save_stats = mapbuffer_save_stats();
 
     map &here = get_map();
 
     static_popup popup;
 
-    // A set of already-saved submaps, in global overmap coordinates.
-    std::set<tripoint_abs_omt> saved_submaps;
     std::list<tripoint_abs_sm> submaps_to_delete;
     static constexpr std::chrono::milliseconds update_interval( 500 );
     std::chrono::steady_clock::time_point last_update = std::chrono::steady_clock::now();
 
-    for( auto &elem : submaps ) {
+    for( const tripoint_abs_omt &om_addr : held_quads.positions() ) {
         std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
         if( last_update + update_interval < now ) {
             popup.message( _( "Please wait as the map saves [%d/%d]" ),
@@ -161,20 +394,9 @@ void mapbuffer::save( bool delete_after_save )
             inp_mngr.pump_events();
             last_update = now;
         }
-        // Whatever the coordinates of the current submap are,
-        // we're saving a 2x2 quad of submaps at a time.
-        // Submaps are generated in quads, so we know if we have one member of a quad,
-        // we have the rest of it, if that assumption is broken we have REAL problems.
-        const tripoint_abs_omt om_addr = project_to<coords::omt>( elem.first );
-        if( saved_submaps.count( om_addr ) != 0 ) {
-            // Already handled this one.
-            continue;
-        }
-        saved_submaps.insert( om_addr );
 
         // A segment is a chunk of 32x32 submap quads.
         // We're breaking them into subdirectories so there aren't too many files per directory.
-        // Might want to make a set for this one too so it's only checked once per save().
         const cata_path dirname = find_dirname( om_addr );
         const cata_path quad_path = find_quad_path( dirname, om_addr );
 
@@ -188,27 +410,71 @@ void mapbuffer::save( bool delete_after_save )
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    DebugLog( D_INFO, D_MAP ) << "Map saved: " << last_save_stats.written << " quads written, "
+                              << last_save_stats.unchanged << " unchanged, "
+                              << last_save_stats.uniform << " uniform";
+}
+
+void mapbuffer::evict_cold_quads()
+{
+    evict_cold_quads( std::max( get_option<int>( "MAP_QUAD_CACHE_SIZE" ), 0 ) );
+}
+
+void mapbuffer::evict_cold_quads( size_t max_quads )
+{
+    // Nothing was loaded since the last attempt, which could not get below the limit
+    if( held_quads.size() <= max_quads || held_quads.size() <= quads_after_eviction ) {
+        return;
+    }
+
+    map &here = get_map();
+    std::vector<std::pair<uint64_t, tripoint_abs_omt>> candidates;
+    for( const tripoint_abs_omt &pos : held_quads.positions() ) {
+        if( !here.inbounds( pos ) ) {
+            candidates.emplace_back( held_quads.find( pos )->last_used, pos );
+        }
+    }
+    std::sort( candidates.begin(), candidates.end() );
+
+    int evicted = 0;
+    for( const std::pair<uint64_t, tripoint_abs_omt> &candidate : candidates ) {
+        if( held_quads.size() <= max_quads ) {
+            break;
+        }
+        const tripoint_abs_omt &pos = candidate.second;
+        const buffered_quad &q = *held_quads.find( pos );
+        // Uniform quads are never saved, they are generated again instead
+        const bool uniform = std::all_of( q.submaps.begin(), q.submaps.end(),
+        []( const std::unique_ptr<submap> &sm ) {
+            return sm == nullptr || ( sm->is_uniform() && !sm->reverted );
+        } );
+        const cata_path dirname = find_dirname( pos );
+        if( uniform || quad_is_saved( find_quad_path( dirname, pos ),
+                                      find_binary_quad_path( dirname, pos ), q, true ) ) {
+            held_quads.erase( pos );
+            ++evicted;
+        }
+    }
+    quads_after_eviction = held_quads.size();
+    dbg( D_INFO ) << "Evicted " << evicted << " map quads, " << quads_after_eviction << " left";
 }
 
 void mapbuffer::save_quad(
     const cata_path &dirname, const cata_path &filename, const tripoint_abs_omt &om_addr,
     std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save )
 {
-    std::vector<point> offsets;
+    buffered_quad &q = *held_quads.find( om_addr );
     std::vector<tripoint_abs_sm> submap_addrs;
-    offsets.push_back( point_zero );
-    offsets.push_back( point_south );
-    offsets.push_back( point_east );
-    offsets.push_back( point_south_east );
 
+    const cata_path binary_filename = find_binary_quad_path( dirname, om_addr );
     bool all_uniform = true;
     bool reverted_to_uniform = false;
-    bool const file_exists = fs::exists( filename.get_unrelative_path() );
-    for( point &offsets_offset : offsets ) {
-        tripoint_abs_sm submap_addr = project_to<coords::sm>( om_addr );
-        submap_addr += offsets_offset;
+    bool const file_exists = fs::exists( filename.get_unrelative_path() ) ||
+                             fs::exists( binary_filename.get_unrelative_path() );
+    for( const point &offset : quad_offsets ) {
+        const tripoint_abs_sm submap_addr = project_to<coords::sm>( om_addr ) + offset;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr].get();
+        const submap *sm = quad_slot( q, submap_addr ).get();
         if( sm != nullptr ) {
             if( !sm->is_uniform() ) {
                 all_uniform = false;
@@ -221,8 +487,8 @@ void mapbuffer::save_quad(
     if( all_uniform ) {
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
-            for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+            for( const tripoint_abs_sm &submap_addr : submap_addrs ) {
+                if( quad_slot( q, submap_addr ) != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -231,21 +497,30 @@ void mapbuffer::save_quad(
         // deleting the file might fail on some platforms in some edge cases so force serialize this
         // uniform quad
         if( !reverted_to_uniform ) {
+            ++last_save_stats.uniform;
             return;
         }
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
+    if( !reverted_to_uniform && quad_is_saved( filename, binary_filename, q, delete_after_save ) ) {
+        if( delete_after_save ) {
+            for( const tripoint_abs_sm &submap_addr : submap_addrs ) {
+                if( quad_slot( q, submap_addr ) != nullptr ) {
+                    submaps_to_delete.push_back( submap_addr );
+                }
             }
+        }
+        ++last_save_stats.unchanged;
+        return;
+    }
+
+    // Any staged copy of this quad would be outdated after this
+    take_staged_quad( om_addr );
 
-            submap *sm = submaps[submap_addr].get();
+    const auto write_quad = [&]( JsonOut & jsout ) {
+        jsout.start_array();
+        for( const tripoint_abs_sm &submap_addr : submap_addrs ) {
+            submap *sm = quad_slot( q, submap_addr ).get();
 
             if( sm == nullptr ) {
                 continue;
@@ -272,51 +547,190 @@ void mapbuffer::save_quad(
         }
 
         jsout.end_array();
-    } );
+    };
+
+    // Don't create the directory if it would be empty
+    assure_dir_exist( dirname );
+    // Whichever format is not written is removed, so that switching formats migrates the quads
+    // as they are saved.
+    if( get_option<bool>( "BINARY_MAP_SAVES" ) ) {
+        flexbuffers::Builder builder;
+        JsonOut jsout( builder );
+        write_quad( jsout );
+        builder.Finish();
+        const std::vector<uint8_t> &flexbuffer = builder.GetBuffer();
+        write_to_file( binary_filename, [&]( std::ostream & fout ) {
+            fout.write( binary_quad_header.data(), binary_quad_header.size() );
+            fout.write( reinterpret_cast<const char *>( flexbuffer.data() ), flexbuffer.size() );
+        } );
+        get_save_writer().wait_for( filename.get_unrelative_path() );
+        remove_file( filename.get_unrelative_path() );
+    } else {
+        write_to_file( filename, [&]( std::ostream & fout ) {
+            JsonOut jsout( fout );
+            write_quad( jsout );
+        } );
+        get_save_writer().wait_for( binary_filename.get_unrelative_path() );
+        remove_file( binary_filename.get_unrelative_path() );
+    }
+
+    for( const std::unique_ptr<submap> &sm : q.submaps ) {
+        if( sm != nullptr ) {
+            sm->set_saved();
+        }
+    }
+    ++last_save_stats.written;
 
     if( all_uniform && reverted_to_uniform ) {
+        get_save_writer().wait_for( filename.get_unrelative_path() );
+        get_save_writer().wait_for( binary_filename.get_unrelative_path() );
         fs::remove( filename.get_unrelative_path() );
+        fs::remove( binary_filename.get_unrelative_path() );
     }
 }
 
+bool mapbuffer::quad_is_saved( const cata_path &filename, const cata_path &binary_filename,
+                               const buffered_quad &q, bool delete_after_save ) const
+{
+    // Submaps in the reality bubble get their last_touched bumped on every save. Writing them
+    // for that alone would write the whole bubble every time, so that is only done once in a
+    // while. Submaps that are about to be dropped must be written with their final value.
+    static constexpr time_duration last_touched_save_interval = 1_hours;
+
+    const cata_path &current = get_option<bool>( "BINARY_MAP_SAVES" ) ? binary_filename : filename;
+    const fs::path current_path = current.get_unrelative_path();
+    if( !get_save_writer().is_queued( current_path ) && !fs::exists( current_path ) ) {
+        return false;
+    }
+    for( const std::unique_ptr<submap> &sm : q.submaps ) {
+        if( sm == nullptr ) {
+            continue;
+        }
+        if( sm->modified_since_saved() ) {
+            return false;
+        }
+        const time_duration untouched = sm->last_touched - sm->get_saved_last_touched();
+        if( delete_after_save ? untouched != 0_turns : untouched >= last_touched_save_interval ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void mapbuffer::prefetch_quads( const std::vector<tripoint_abs_omt> &quads )
+{
+    cata::thread_pool &pool = get_thread_pool();
+    if( pool.num_workers() == 0 ) {
+        return;
+    }
+
+    const std::set<tripoint_abs_omt> wanted( quads.begin(), quads.end() );
+    std::lock_guard<std::mutex> lock( prefetch_mutex );
+    // Forget about finished quads that were not needed after all, the prediction changed.
+    for( auto it = staged.begin(); it != staged.end(); ) {
+        if( it->second->done && !wanted.count( it->first ) ) {
+            it = staged.erase( it );
+        } else {
+            ++it;
+        }
+    }
+
+    for( const tripoint_abs_omt &om_addr : quads ) {
+        if( staged.count( om_addr ) || held_quads.find( om_addr ) ) {
+            continue;
+        }
+        std::shared_ptr<staged_quad> quad = std::make_shared<staged_quad>();
+        // PATH_INFO is not thread safe, so the directory is found here.
+        quad->path = find_dirname( om_addr );
+        staged.emplace( om_addr, quad );
+        ++prefetches_running;
+        pool.submit( [this, om_addr, quad]() {
+            std::optional<JsonValue> json;
+            std::string error;
+            try {
+                json = read_quad( resolve_quad_path( quad->path, om_addr ) );
+            } catch( const std::exception &err ) {
+                error = err.what();
+            }
+            {
+                std::lock_guard<std::mutex> lock( prefetch_mutex );
+                quad->json = std::move( json );
+                quad->error = std::move( error );
+                quad->done = true;
+                --prefetches_running;
+            }
+            prefetch_done.notify_all();
+        } );
+    }
+}
+
+std::shared_ptr<mapbuffer::staged_quad> mapbuffer::take_staged_quad(
+    const tripoint_abs_omt &om_addr )
+{
+    std::unique_lock<std::mutex> lock( prefetch_mutex );
+    const auto it = staged.find( om_addr );
+    if( it == staged.end() ) {
+        return nullptr;
+    }
+    std::shared_ptr<staged_quad> quad = it->second;
+    staged.erase( it );
+    prefetch_done.wait( lock, [&quad] {
+        return quad->done;
+    } );
+    return quad;
+}
+
 // We're reading in way too many entities here to mess around with creating sub-objects and
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
 {
     // Map the tripoint to the submap quad that stores it.
     const tripoint_abs_omt om_addr = project_to<coords::omt>( p );
-    const cata_path dirname = find_dirname( om_addr );
-    cata_path quad_path = find_quad_path( dirname, om_addr );
-
-    if( !file_exist( quad_path ) ) {
-        // Fix for old saves where the path was generated using std::stringstream, which
-        // did format the number using the current locale. That formatting may insert
-        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-        // of "map/1234.7.8.map".
-        std::ostringstream buffer;
-        buffer << om_addr.x() << "." << om_addr.y() << "." << om_addr.z()
-               << ".map";
-        cata_path legacy_quad_path = dirname / buffer.str();
-        if( file_exist( legacy_quad_path ) ) {
-            quad_path = std::move( legacy_quad_path );
+    cata_path quad_path;
+    std::optional<JsonValue> quad_json;
+    std::string error;
+
+    // Prefer a quad that was read in the background, it only needs to be deserialized here.
+    if( std::shared_ptr<staged_quad> quad = take_staged_quad( om_addr ) ) {
+        ++prefetch_stats.hits;
+        quad_path = resolve_quad_path( quad->path, om_addr );
+        quad_json = std::move( quad->json );
+        error = std::move( quad->error );
+    } else {
+        ++prefetch_stats.misses;
+        quad_path = resolve_quad_path( find_dirname( om_addr ), om_addr );
+        try {
+            quad_json = read_quad( quad_path );
+        } catch( const std::exception &err ) {
+            error = err.what();
         }
     }
 
-    if( !read_from_file_optional_json( quad_path, [this]( const JsonValue & jsin ) {
-    deserialize( jsin );
-    } ) ) {
+    if( error.empty() && quad_json ) {
+        try {
+            deserialize( *quad_json );
+        } catch( const std::exception &err ) {
+            error = err.what();
+        }
+    }
+    if( !error.empty() ) {
+        debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path.generic_u8string(), error );
+        return nullptr;
+    }
+    if( !quad_json ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
     // fill in uniform submaps that were not serialized
     oter_id const oid = overmap_buffer.ter( om_addr );
     generate_uniform_omt( project_to<coords::sm>( om_addr ), oid );
-    if( submaps.count( p ) == 0 ) {
+    submap *sm = find_submap( p );
+    if( sm == nullptr ) {
         debugmsg( "file %s did not contain the expected submap %s for non-uniform terrain %s",
                   quad_path.generic_u8string(), p.to_string(), oid.id().str() );
         return nullptr;
     }
-    return submaps[ p ].get();
+    return sm;
 }
 
 void mapbuffer::deserialize( const JsonArray &ja )
@@ -340,6 +754,10 @@ void mapbuffer::deserialize( const JsonArray &ja )
             }
         }
 
+        // Submaps from older versions are written again to upgrade them
+        if( version == savegame_version ) {
+            sm->set_saved();
+        }
         if( !add_submap( submap_coordinates, sm ) ) {
             debugmsg( "submap %s was already loaded", submap_coordinates.to_string() );
         }
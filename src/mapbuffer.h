@@ -2,17 +2,40 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
-#include "coords_fwd.h"
+#include "coordinates.h"
 #include "point.h"
 
 class cata_path;
 class JsonArray;
 class submap;
+struct submap_item_stats;
+
+struct submap_prefetch_stats {
+    // Quads that were already read and parsed in the background when they were needed
+    int hits = 0;
+    // Quads that had to be read and parsed on the spot
+    int misses = 0;
+};
+
+struct mapbuffer_save_stats {
+    // Quads written to disk
+    int written = 0;
+    // Quads skipped because their file is already up to date
+    int unchanged = 0;
+    // Quads skipped because they are uniform and will be regenerated
+    int uniform = 0;
+};
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -66,28 +89,114 @@ class mapbuffer
         // submap exists or not.
         bool submap_exists( const tripoint_abs_sm &p );
 
-    private:
-        using submap_map_t = std::map<tripoint_abs_sm, std::unique_ptr<submap>>;
-
-    public:
-        inline submap_map_t::iterator begin() {
-            return submaps.begin();
+        /**
+         * Starts reading and parsing the quads at the given overmap terrain locations on the
+         * worker threads, so that loading one of their submaps later only has to deserialize
+         * the already parsed data. Quads that are already buffered or staged are skipped.
+         * Staged quads that are not in @p quads and were never loaded are dropped.
+         * Does nothing if there are no worker threads.
+         */
+        void prefetch_quads( const std::vector<tripoint_abs_omt> &quads );
+        const submap_prefetch_stats &get_prefetch_stats() const {
+            return prefetch_stats;
+        }
+        void reset_prefetch_stats() {
+            prefetch_stats = submap_prefetch_stats();
+        }
+        /** What the last call to @ref save did with the buffered quads. */
+        const mapbuffer_save_stats &get_last_save_stats() const {
+            return last_save_stats;
         }
-        inline submap_map_t::iterator end() {
-            return submaps.end();
+
+        /** Number of quads held, counting partially held ones. */
+        size_t quad_count() const {
+            return held_quads.size();
         }
+        /** Items on all held submaps and the memory they take up. */
+        submap_item_stats item_stats() const;
+        /**
+         * Drops the least recently used quads outside the reality bubble until no more than
+         * @p max_quads are held. Only quads whose files are up to date are dropped, they are
+         * read back when they are needed again. Changed quads stay until they are saved.
+         */
+        void evict_cold_quads( size_t max_quads );
+        /** @ref evict_cold_quads with the limit from the "MAP_QUAD_CACHE_SIZE" option. */
+        void evict_cold_quads();
 
     private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( const tripoint_abs_sm &addr );
+
+        // The four submaps of one overmap terrain on one z-level, which are always loaded
+        // and saved together.
+        struct buffered_quad {
+            tripoint_abs_omt pos;
+            std::array<std::unique_ptr<submap>, 4> submaps;
+            // Value of use_clock at the last lookup, for the eviction order
+            uint64_t last_used = 0;
+
+            bool empty() const;
+        };
+
+        // Open addressing hash table of quads with linear probing.
+        // The quads themselves never move, so pointers to them and their submaps stay valid
+        // until they are erased.
+        class quad_table
+        {
+            public:
+                buffered_quad *find( const tripoint_abs_omt &pos ) const;
+                // Returns the existing quad at pos, or a new empty one
+                buffered_quad &find_or_insert( const tripoint_abs_omt &pos );
+                void erase( const tripoint_abs_omt &pos );
+                void clear();
+                size_t size() const {
+                    return count;
+                }
+                // Positions of all quads, the table may be changed while going through them
+                std::vector<tripoint_abs_omt> positions() const;
+
+            private:
+                size_t slot_of( const tripoint_abs_omt &pos ) const;
+                void grow();
+
+                // Always a power of two in size
+                std::vector<std::unique_ptr<buffered_quad>> slots;
+                int slot_bits = 0;
+                size_t count = 0;
+        };
+
+        // Where the submap at p lives in its quad
+        static std::unique_ptr<submap> &quad_slot( buffered_quad &q, const tripoint_abs_sm &p );
+        // The submap at p if it is held, without loading it or counting it as used
+        submap *find_submap( const tripoint_abs_sm &p ) const;
+
         submap *unserialize_submaps( const tripoint_abs_sm &p );
         void deserialize( const JsonArray &ja );
         void save_quad(
             const cata_path &dirname, const cata_path &filename,
             const tripoint_abs_omt &om_addr, std::list<tripoint_abs_sm> &submaps_to_delete,
             bool delete_after_save );
-        submap_map_t submaps; // NOLINT(cata-serialize)
+        // Whether the quad file in the current format already holds the buffered submaps
+        bool quad_is_saved( const cata_path &filename, const cata_path &binary_filename,
+                            const buffered_quad &q, bool delete_after_save ) const;
+        quad_table held_quads; // NOLINT(cata-serialize)
+        uint64_t use_clock = 0; // NOLINT(cata-serialize)
+        // Quads held after the last eviction that could not get below the limit
+        size_t quads_after_eviction = 0; // NOLINT(cata-serialize)
+
+        // A quad file that is being read, or has been read, by a worker thread.
+        struct staged_quad;
+        // Waits for the staged quad to finish and removes it from the staging area.
+        // Returns nullptr if the quad was not staged.
+        std::shared_ptr<staged_quad> take_staged_quad( const tripoint_abs_omt &om_addr );
+        // Guards staged and prefetches_running, which are shared with the worker threads
+        std::mutex prefetch_mutex; // NOLINT(cata-serialize)
+        std::condition_variable prefetch_done; // NOLINT(cata-serialize)
+        std::map<tripoint_abs_omt, std::shared_ptr<staged_quad>> staged; // NOLINT(cata-serialize)
+        int prefetches_running = 0; // NOLINT(cata-serialize)
+        submap_prefetch_stats prefetch_stats; // NOLINT(cata-serialize)
+        mapbuffer_save_stats last_save_stats; // NOLINT(cata-serialize)
 };
 
 extern mapbuffer MAPBUFFER;
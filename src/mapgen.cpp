@@ -6871,6 +6871,7 @@ void map::add_spawn(
     if( MonsterGroupManager::monster_is_blacklisted( type ) ) {
         return;
     }
+    place_on_submap->mark_modified();
     place_on_submap->spawns.emplace_back( type, count, offset, faction_id, mission_id, friendly, name,
                                           data );
 }
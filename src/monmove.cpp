@@ -6,6 +6,7 @@
 #include <climits>
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <memory>
@@ -303,7 +304,7 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
         return FLT_MAX;
     }
 
-    if( !sees( c ) ) {
+    if( !sees_planned( c ) ) {
         return FLT_MAX;
     }
 
@@ -454,6 +455,69 @@ bool monster::mating_angry() const
     return mating_angry;
 }
 
+void monster::plan_sight()
+{
+    planned_sight.clear();
+    planned_sight_from = get_location();
+    const auto plan_for = [this]( const Creature &critter ) {
+        planned_sight.push_back( { &critter, critter.get_location(), sees( critter ) } );
+    };
+
+    // The same candidates plan() rates, erring on the side of too many. Without smart planning
+    // nothing beyond our own sight range is ever rated, see rate_target.
+    const bool smart_planning = has_flag( mon_flag_PRIORITIZE_TARGETS );
+    const int range = smart_planning ? MAX_VIEW_DISTANCE :
+                      std::min( MAX_VIEW_DISTANCE, std::max( type->vision_day, type->vision_night ) );
+    const bool rates_allies = has_flag( mon_flag_GROUP_MORALE ) || has_flag( mon_flag_SWARMS );
+    if( friendly == 0 ) {
+        plan_for( get_player_character() );
+    }
+    for( const npc &who : g->all_npcs() ) {
+        const mf_attitude faction_att = faction.obj().attitude( who.get_monster_faction() );
+        if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY ) {
+            plan_for( who );
+        }
+    }
+    for( const monster *other : get_creature_tracker().monsters_near( get_location(), range,
+            fov_3d_z_range ) ) {
+        if( other == this ) {
+            continue;
+        }
+        bool rated = rates_allies || ( friendly == 0 ) != ( other->friendly == 0 );
+        if( !rated && friendly == 0 ) {
+            const mf_attitude faction_att = faction.obj().attitude( other->faction );
+            rated = faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+        }
+        if( rated ) {
+            plan_for( *other );
+        }
+    }
+    std::sort( planned_sight.begin(), planned_sight.end(),
+    []( const planned_sight_entry & lhs, const planned_sight_entry & rhs ) {
+        return std::less<const Creature *>()( lhs.target, rhs.target );
+    } );
+}
+
+bool monster::sees_planned( const Creature &critter ) const
+{
+    if( !planned_sight.empty() && planned_sight_from == get_location() ) {
+        const auto iter = std::lower_bound( planned_sight.begin(), planned_sight.end(), &critter,
+        []( const planned_sight_entry & entry, const Creature * target ) {
+            return std::less<const Creature *>()( entry.target, target );
+        } );
+        if( iter != planned_sight.end() && iter->target == &critter &&
+            iter->target_location == critter.get_location() ) {
+            return iter->seen;
+        }
+    }
+    return sees( critter );
+}
+
+void monster::forget_planned_sight()
+{
+    planned_sight.clear();
+}
+
 void monster::plan()
 {
     monster_plan mon_plan( *this );
@@ -464,7 +528,7 @@ void monster::plan()
     Character &player_character = get_player_character();
     // If we can see the player, move toward them or flee.
     if( friendly == 0 && seen_levels.test( player_character.pos().z + OVERMAP_DEPTH ) &&
-        sees( player_character ) ) {
+        sees_planned( player_character ) ) {
         mon_plan.dist = rate_target( player_character, mon_plan.dist, mon_plan.smart_planning );
         mon_plan.fleeing = mon_plan.fleeing || is_fleeing( player_character );
         mon_plan.target = &player_character;
@@ -487,12 +551,15 @@ void monster::plan()
         }
         anger_cub_threatened( mon_plan );
     } else if( friendly != 0 && !mon_plan.docile ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 && tmp.attitude_to( *this ) == Attitude::HOSTILE &&
-                seen_levels.test( tmp.pos().z + OVERMAP_DEPTH ) ) {
-                float rating = rate_target( tmp, mon_plan.dist, mon_plan.smart_planning );
+        // Nothing further away than this can be seen (see Creature::sees), so there is no
+        // point in rating it.
+        for( monster *tmp : get_creature_tracker().monsters_near( get_location(), MAX_VIEW_DISTANCE,
+                fov_3d_z_range ) ) {
+            if( tmp->friendly == 0 && tmp->attitude_to( *this ) == Attitude::HOSTILE &&
+                seen_levels.test( tmp->pos().z + OVERMAP_DEPTH ) ) {
+                float rating = rate_target( *tmp, mon_plan.dist, mon_plan.smart_planning );
                 if( rating < mon_plan.dist ) {
-                    mon_plan.target = &tmp;
+                    mon_plan.target = tmp;
                     mon_plan.dist = rating;
                 }
             }
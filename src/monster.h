@@ -250,6 +250,15 @@ class monster : public Creature
         // is it mating season?
         bool mating_angry() const;
         void plan();
+        /**
+         * Works out ahead of time which of the creatures plan() is about to rate this monster
+         * can see. Only reads shared state and writes nothing but this monster, so it can be
+         * run for many monsters at once while the map is frozen, see monmove().
+         */
+        void plan_sight();
+        /** Like sees( critter ), but answered by plan_sight() while neither of them moved since. */
+        bool sees_planned( const Creature &critter ) const;
+        void forget_planned_sight();
         void anger_hostile_seen( const monster_plan &mon_plan );
         void anger_mating_season( const monster_plan &mon_plan );
         // will change mon_plan::dist
@@ -655,6 +664,15 @@ class monster : public Creature
         std::bitset<NUM_MEFF> effect_cache;
         int turns_since_target = 0;
 
+        struct planned_sight_entry {
+            const Creature *target;
+            tripoint_abs_ms target_location;
+            bool seen;
+        };
+        /** Results of plan_sight(), sorted by target, only valid while we stay at planned_sight_from */
+        std::vector<planned_sight_entry> planned_sight;
+        tripoint_abs_ms planned_sight_from;
+
         Character *find_dragged_foe();
         void nursebot_operate( Character *dragged_foe );
 
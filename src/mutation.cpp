@@ -10,6 +10,7 @@
 #include "avatar_action.h"
 #include "avatar.h"
 #include "bionics.h"
+#include "cata_scope_helpers.h"
 #include "character_attire.h"
 #include "character.h"
 #include "color.h"
@@ -140,9 +141,8 @@ bool Character::has_trait_flag( const json_character_flag &b ) const
         if( mut_data.flags.count( b ) > 0 ) {
             return true;
         } else if( mut_data.activated ) {
-            Character &player = get_player_character();
-            if( ( mut_data.active_flags.count( b ) > 0 && player.has_active_mutation( mut ) ) ||
-                ( mut_data.inactive_flags.count( b ) > 0 && !player.has_active_mutation( mut ) ) ) {
+            if( ( mut_data.active_flags.count( b ) > 0 && has_active_mutation( mut ) ) ||
+                ( mut_data.inactive_flags.count( b ) > 0 && !has_active_mutation( mut ) ) ) {
                 return true;
             }
         }
@@ -160,9 +160,8 @@ int Character::count_trait_flag( const json_character_flag &b ) const
         if( mut_data.flags.count( b ) > 0 ) {
             ret++;
         } else if( mut_data.activated ) {
-            Character &player = get_player_character();
-            if( ( mut_data.active_flags.count( b ) > 0 && player.has_active_mutation( mut ) ) ||
-                ( mut_data.inactive_flags.count( b ) > 0 && !player.has_active_mutation( mut ) ) ) {
+            if( ( mut_data.active_flags.count( b ) > 0 && has_active_mutation( mut ) ) ||
+                ( mut_data.inactive_flags.count( b ) > 0 && !has_active_mutation( mut ) ) ) {
                 ret++;
             }
         }
@@ -297,6 +296,7 @@ void Character::set_mutation_unsafe( const trait_id &trait, const mutation_varia
     }
     my_mutations.emplace( trait, trait_data{variant} );
     cached_mutations.push_back( &trait.obj() );
+    invalidate_flag_cache();
     if( !trait.obj().vanity ) {
         mutation_effect( trait, false );
     }
@@ -352,6 +352,7 @@ void Character::unset_mutation( const trait_id &trait_ )
     cached_mutations.erase( std::remove( cached_mutations.begin(), cached_mutations.end(), &mut ),
                             cached_mutations.end() );
     my_mutations.erase( iter );
+    invalidate_flag_cache();
     if( !mut.vanity ) {
         mutation_loss_effect( trait );
     }
@@ -370,6 +371,7 @@ void Character::switch_mutations( const trait_id &switched, const trait_id &targ
     }
     if( has_trait( target ) ) {
         my_mutations[target].powered = start_powered;
+        invalidate_flag_cache();
     }
 }
 
@@ -557,6 +559,8 @@ void Character::recalculate_size()
 
 void Character::mutation_effect( const trait_id &mut, const bool worn_destroyed_override )
 {
+    // Some traits provide tools for crafting
+    crafting_cache.valid = false;
     if( mut == trait_GLASSJAW ) {
         recalc_hp();
     } else {
@@ -630,6 +634,7 @@ void Character::mutation_effect( const trait_id &mut, const bool worn_destroyed_
 
     if( branch.starts_active ) {
         my_mutations[mut].powered = true;
+        invalidate_flag_cache();
     }
 
     on_mutation_gain( mut );
@@ -637,6 +642,7 @@ void Character::mutation_effect( const trait_id &mut, const bool worn_destroyed_
 
 void Character::mutation_loss_effect( const trait_id &mut )
 {
+    crafting_cache.valid = false;
     if( mut == trait_GLASSJAW ) {
         recalc_hp();
     } else {
@@ -795,6 +801,10 @@ void Character::activate_mutation( const trait_id &mut )
 {
     const mutation_branch &mdata = mut.obj();
     trait_data &tdata = my_mutations[mut];
+    // The mutation may be switched on or off again on any of the ways out
+    on_out_of_scope invalidate_flags( [this]() {
+        invalidate_flag_cache();
+    } );
     int cost = mdata.cost;
     // You can take yourself halfway to Near Death levels of hunger/thirst.
     // Sleepiness can go to Exhausted.
@@ -972,6 +982,7 @@ void Character::activate_mutation( const trait_id &mut )
 void Character::deactivate_mutation( const trait_id &mut )
 {
     my_mutations[mut].powered = false;
+    invalidate_flag_cache();
 
     // Handle stat changes from deactivation
     apply_mods( mut, false );
@@ -930,6 +930,7 @@ void Character::initialize( bool learn_recipes )
             my_mutations[mut].powered = true;
         }
     }
+    invalidate_flag_cache();
 
     // Ensure that persistent morale effects (e.g. Optimist) are present at the start.
     apply_persistent_morale();
@@ -4778,6 +4779,7 @@ void Character::clear_mutations()
         mutation_loss_effect( trait );
     }
     cached_mutations.clear();
+    invalidate_flag_cache();
     recalc_sight_limits();
     calc_encumbrance();
 }
@@ -1650,6 +1650,11 @@ void options_manager::add_options_general()
            );
 
         get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
+
+        add( "BACKGROUND_SAVES", page_id, to_translation( "Save in the background" ),
+             to_translation( "If true, autosaves and quicksaves only prepare the save files and let a background thread write them to disk, so that the game does not stop while they are written." ),
+             true
+           );
     } );
 
     add_empty_line();
@@ -2925,6 +2930,23 @@ void options_manager::add_options_debug()
 
     add_empty_line();
 
+    add( "WORKER_THREADS", "debug", to_translation( "Worker threads" ),
+         to_translation( "Number of background threads used to split up expensive per-turn work, such as rebuilding the map caches of each z-level.  0 does all of the work on the main thread." ),
+         0, 32, 0
+       );
+
+    add( "BINARY_MAP_SAVES", "debug", to_translation( "Binary map saves" ),
+         to_translation( "If true, the map is saved in a binary format that is faster to load.  Already saved parts of the map are converted when they are saved again, this also goes for converting back when this is turned off." ),
+         false
+       );
+
+    add( "MAP_QUAD_CACHE_SIZE", "debug", to_translation( "Map quads kept in memory" ),
+         to_translation( "Number of map quads (2x2 submaps of one z-level) kept in memory.  When there are more, the least recently used ones outside the reality bubble are dropped if they are already saved, and read back from the save when they are needed again." ),
+         1024, 1000000, 16384
+       );
+
+    add_empty_line();
+
     add_option_group( "debug", Group( "occlusion_opts", to_translation( "Occlusion Options" ),
                                       to_translation( "Options regarding occlusion." ) ),
     [&]( const std::string & page_id ) {
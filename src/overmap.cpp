@@ -6,6 +6,7 @@
 #include <cmath>
 #include <cstring>
 #include <exception>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -3144,6 +3145,64 @@ void overmap::init_layers()
         l.visible.fill( om_vision_level::unseen );
         l.explored.fill( false );
     }
+    invalidate_indices();
+}
+
+void overmap::invalidate_indices()
+{
+    for( omt_layer_index &index : ter_index ) {
+        index.dirty = true;
+    }
+    special_index_dirty = true;
+}
+
+void overmap::find_indexed_ter( const int z, const int min_x, const int max_x,
+                                const std::function<bool( const oter_id & )> &matches,
+                                const std::function<void( const tripoint_om_omt & )> &fn ) const
+{
+    static_assert( OMAPX * OMAPY <= std::numeric_limits<uint16_t>::max() + 1,
+                   "omt_layer_index packs locations into 16 bits" );
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT || min_x > max_x ) {
+        return;
+    }
+    omt_layer_index &index = ter_index[z + OVERMAP_DEPTH];
+    if( index.dirty ) {
+        index.locations.clear();
+        const cata::mdarray<oter_id, point_om_omt> &terrain = layer[z + OVERMAP_DEPTH].terrain;
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                index.locations[terrain[x][y]].push_back( static_cast<uint16_t>( x * OMAPY + y ) );
+            }
+        }
+        index.dirty = false;
+    }
+    const uint16_t first = static_cast<uint16_t>( std::max( min_x, 0 ) * OMAPY );
+    const int last = std::min( max_x, OMAPX - 1 ) * OMAPY + OMAPY - 1;
+    for( const std::pair<const oter_id, std::vector<uint16_t>> &entry : index.locations ) {
+        if( !matches( entry.first ) ) {
+            continue;
+        }
+        const std::vector<uint16_t> &locations = entry.second;
+        for( auto it = std::lower_bound( locations.begin(), locations.end(), first );
+             it != locations.end() && *it <= last; ++it ) {
+            fn( tripoint_om_omt( *it / OMAPY, *it % OMAPY, z ) );
+        }
+    }
+}
+
+const std::vector<tripoint_om_omt> &overmap::special_locations( const overmap_special_id &id ) const
+{
+    if( special_index_dirty ) {
+        special_index.clear();
+        for( const std::pair<const tripoint_om_omt, overmap_special_id> &placement :
+             overmap_special_placements ) {
+            special_index[placement.second].push_back( placement.first );
+        }
+        special_index_dirty = false;
+    }
+    static const std::vector<tripoint_om_omt> none;
+    const auto it = special_index.find( id );
+    return it == special_index.end() ? none : it->second;
 }
 
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
@@ -3184,6 +3243,9 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         // We had a predecessor, and it was the same type as the incoming one
         // Don't push another copy.
     }
+    if( current_oter != id ) {
+        ter_index[p.z() + OVERMAP_DEPTH].dirty = true;
+    }
     current_oter = id;
 }
 
@@ -3628,6 +3690,7 @@ void overmap::generate( const overmap *north, const overmap *east,
                     layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
                 }
             }
+            ter_index[z + OVERMAP_DEPTH].dirty = true;
         }
     }
     calculate_urbanity();
@@ -4166,6 +4229,7 @@ void overmap::clear_mon_groups()
 void overmap::clear_overmap_special_placements()
 {
     overmap_special_placements.clear();
+    special_index_dirty = true;
 }
 void overmap::clear_cities()
 {
@@ -6943,6 +7007,7 @@ std::vector<tripoint_om_omt> overmap::place_special(
     for( const std::pair<om_pos_dir, std::string> &join : result.joins_used ) {
         joins_used[join.first] = join.second;
     }
+    special_index_dirty = true;
     for( const tripoint_om_omt &location : result.omts_used ) {
         overmap_special_placements[location] = special.id;
         mapgen_args_index[location] = mapgen_args_p;
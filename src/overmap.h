@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -117,6 +118,14 @@ struct map_layer {
     std::vector<om_map_extra> extras;
 };
 
+// Locations of each terrain on one overmap layer, so terrain can be looked up by type without
+// scanning every OMT. Rebuilt on demand after the layer changed.
+struct omt_layer_index {
+    bool dirty = true;
+    // Packed as x * OMAPY + y, in ascending order
+    std::unordered_map<oter_id, std::vector<uint16_t>> locations;
+};
+
 struct om_special_sectors {
     std::vector<point_om_omt> sectors;
     int sector_width;
@@ -246,6 +255,15 @@ class overmap
          * coordinates), or empty vector if no matching terrain is found.
          */
         std::vector<point_abs_omt> find_terrain( std::string_view term, int zlevel ) const;
+        /**
+         * Calls @p fn with every location on layer @p z, with x in [min_x, max_x], whose terrain
+         * satisfies @p matches. @p matches is asked once per distinct terrain on the layer.
+         */
+        void find_indexed_ter( int z, int min_x, int max_x,
+                               const std::function<bool( const oter_id & )> &matches,
+                               const std::function<void( const tripoint_om_omt & )> &fn ) const;
+        /** Returns the locations that were placed as part of an instance of the special. */
+        const std::vector<tripoint_om_omt> &special_locations( const overmap_special_id &id ) const;
 
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
         // ter has bounds checking, and returns ot_null when out of bounds.
@@ -373,6 +391,12 @@ class overmap
         std::optional<point_om_omt> fallback_road_connection_point; // NOLINT(cata-serialize)
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
+        // Derived from layer and overmap_special_placements, see find_indexed_ter and special_locations
+        mutable std::array<omt_layer_index, OVERMAP_LAYERS> ter_index; // NOLINT(cata-serialize)
+        mutable std::unordered_map<overmap_special_id, std::vector<tripoint_om_omt>>
+                special_index; // NOLINT(cata-serialize)
+        mutable bool special_index_dirty = true; // NOLINT(cata-serialize)
+        void invalidate_indices();
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
 
         // Records the locations where a given overmap special was placed, which
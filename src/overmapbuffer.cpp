@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <map>
@@ -1143,6 +1144,71 @@ tripoint_abs_omt overmapbuffer::find_closest(
     return find_closest( origin, params );
 }
 
+void overmapbuffer::find_in_overmap( const point_abs_om &om_pos, const tripoint_abs_omt &origin,
+                                     const omt_find_params &params, const int min_dist, const int max_dist,
+                                     const int min_z, const int max_z, std::unordered_map<oter_id, bool> &matches,
+                                     const std::function<void( const tripoint_abs_omt & )> &fn )
+{
+    overmap *om = params.existing_only ? get_existing( om_pos ) : &get( om_pos );
+    if( om == nullptr ) {
+        return;
+    }
+
+    const auto type_matches = [&params, &matches]( const oter_id & oter ) {
+        const auto it = matches.find( oter );
+        if( it != matches.end() ) {
+            return it->second;
+        }
+        const bool result = std::any_of( params.types.begin(), params.types.end(),
+        [&oter]( const std::pair<std::string, ot_match_type> &elem ) {
+            return is_ot_match( elem.first, oter, elem.second );
+        } );
+        matches.emplace( oter, result );
+        return result;
+    };
+    const auto visit = [&]( const tripoint_om_omt & local ) {
+        const tripoint_abs_omt loc = project_combine( om_pos, local );
+        const int dist_xy = square_dist( origin.xy(), loc.xy() );
+        if( dist_xy < min_dist || dist_xy > max_dist ) {
+            return;
+        }
+        if( params.must_see && seen( loc ) == om_vision_level::unseen ) {
+            return;
+        }
+        if( params.cant_see && seen( loc ) != om_vision_level::unseen ) {
+            return;
+        }
+        fn( loc );
+    };
+
+    if( params.om_special ) {
+        for( const tripoint_om_omt &local : om->special_locations( *params.om_special ) ) {
+            if( local.z() >= min_z && local.z() <= max_z &&
+                type_matches( om->ter( local ) ) ) {
+                visit( local );
+            }
+        }
+        return;
+    }
+
+    const point_abs_omt base = project_to<coords::omt>( om_pos );
+    const int min_x = origin.x() - max_dist - base.x();
+    const int max_x = origin.x() + max_dist - base.x();
+    for( int z = min_z; z <= max_z; z++ ) {
+        om->find_indexed_ter( z, min_x, max_x, type_matches, visit );
+    }
+}
+
+// Horizontal distance from p to the closest OMT of the overmap at om_pos
+static int square_dist_to_overmap( const point_abs_omt &p, const point_abs_om &om_pos )
+{
+    const point_abs_omt min_corner = project_to<coords::omt>( om_pos );
+    const point_abs_omt max_corner = min_corner + point( OMAPX - 1, OMAPY - 1 );
+    const point_abs_omt closest( std::clamp( p.x(), min_corner.x(), max_corner.x() ),
+                                 std::clamp( p.y(), min_corner.y(), max_corner.y() ) );
+    return square_dist( p, closest );
+}
+
 tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
@@ -1171,29 +1237,41 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
 
     std::vector<tripoint_abs_omt> result;
     int found_dist = std::numeric_limits<int>::max();
-
-    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
-        const int dist_xy = square_dist( origin.xy(), loc_xy );
-
-        if( found_dist < dist_xy ) {
-            break;
-        }
-
-        for( int z = params.min_z; z <= params.max_z; z++ ) {
-            const tripoint_abs_omt loc( loc_xy, z );
-            const int dist = square_dist( origin, loc );
-
-            if( found_dist < dist ) {
+    const int min_z = params.min_z.value_or( -OVERMAP_DEPTH );
+    const int max_z = params.max_z.value_or( OVERMAP_HEIGHT );
+    std::unordered_map<oter_id, bool> matches;
+
+    // Visit overmaps in rings around the origin, until a whole ring is out of range or farther
+    // away than the closest match found so far.
+    const point_abs_om origin_om = project_to<coords::om>( origin.xy() );
+    for( int ring = 0; ; ++ring ) {
+        bool ring_in_range = false;
+        for( const point_abs_om &om_pos : closest_points_first( origin_om, ring, ring ) ) {
+            const int om_dist = square_dist_to_overmap( origin.xy(), om_pos );
+            if( om_dist > max_dist || om_dist > found_dist ) {
                 continue;
             }
-
-            if( is_findable_location( loc, params ) ) {
-                found_dist = dist;
-                result.push_back( loc );
-            }
+            ring_in_range = true;
+            find_in_overmap( om_pos, origin, params, min_dist, std::min( max_dist, found_dist ), min_z,
+                             max_z, matches,
+            [&]( const tripoint_abs_omt & loc ) {
+                const int dist = square_dist( origin, loc );
+                if( dist < found_dist ) {
+                    found_dist = dist;
+                    result.clear();
+                }
+                if( dist == found_dist ) {
+                    result.push_back( loc );
+                }
+            } );
+        }
+        if( !ring_in_range ) {
+            break;
         }
     }
 
+    // Sort so that the random pick does not depend on the iteration order of the indices
+    std::sort( result.begin(), result.end() );
     return random_entry( result, overmap::invalid_tripoint );
 }
 
@@ -1204,13 +1282,32 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &o
     // dist == 0 means search a whole overmap diameter.
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
-
-    for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-        if( is_findable_location( loc, params ) ) {
-            result.push_back( loc );
+    // Unlike find_closest, only the origin's z-level is searched unless asked otherwise
+    const int min_z = params.min_z.value_or( origin.z() );
+    const int max_z = params.max_z.value_or( origin.z() );
+    std::unordered_map<oter_id, bool> matches;
+
+    const inclusive_rectangle<point_abs_om> overmaps_in_range(
+        project_to<coords::om>( origin.xy() - point( max_dist, max_dist ) ),
+        project_to<coords::om>( origin.xy() + point( max_dist, max_dist ) ) );
+    for( int x = overmaps_in_range.p_min.x(); x <= overmaps_in_range.p_max.x(); ++x ) {
+        for( int y = overmaps_in_range.p_min.y(); y <= overmaps_in_range.p_max.y(); ++y ) {
+            find_in_overmap( point_abs_om( x, y ), origin, params, 0, max_dist, min_z, max_z, matches,
+            [&]( const tripoint_abs_omt & loc ) {
+                const int dist = square_dist( origin, loc );
+                if( dist >= min_dist && dist <= max_dist ) {
+                    result.push_back( loc );
+                }
+            } );
         }
     }
 
+    // Closest first, as callers may prefer earlier entries
+    std::sort( result.begin(), result.end(),
+    [&origin]( const tripoint_abs_omt & lhs, const tripoint_abs_omt & rhs ) {
+        return std::make_pair( square_dist( origin, lhs ), lhs ) <
+               std::make_pair( square_dist( origin, rhs ), rhs );
+    } );
     return result;
 }
 
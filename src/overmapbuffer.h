@@ -127,6 +127,8 @@ struct overmap_with_local_coords {
  * is particularly useful if we want to attempt to add a missing overmap special to an existing
  * overmap rather than creating many overmaps in an attempt to find it.
  * @param om_special If set, the terrain must be part of the specified overmap special.
+ * @param min_z, max_z The z-levels to search. If unset, find_closest searches every z-level
+ * and find_all and find_random only search the z-level of the origin.
 */
 struct omt_find_params {
     std::vector<std::pair<std::string, ot_match_type>> types;
@@ -135,8 +137,8 @@ struct omt_find_params {
     bool must_see = false;
     bool cant_see = false;
     bool existing_only = false;
-    int min_z = -OVERMAP_DEPTH;
-    int max_z = OVERMAP_HEIGHT;
+    std::optional<int> min_z = std::nullopt;
+    std::optional<int> max_z = std::nullopt;
     std::optional<overmap_special_id> om_special = std::nullopt;
 };
 
@@ -547,6 +549,16 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /**
+         * Calls @p fn with every findable location in the overmap at @p om_pos whose horizontal
+         * distance from @p origin is in [min_dist, max_dist] and whose z-level is in [min_z, max_z]. Candidates come from the terrain
+         * and special indices of the overmap, so this does not check every OMT in range.
+         * @param matches Which terrains match params.types, filled in lazily and shared between calls.
+         */
+        void find_in_overmap( const point_abs_om &om_pos, const tripoint_abs_omt &origin,
+                              const omt_find_params &params, int min_dist, int max_dist,
+                              int min_z, int max_z, std::unordered_map<oter_id, bool> &matches,
+                              const std::function<void( const tripoint_abs_omt & )> &fn );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -6,13 +6,14 @@
 #include <iterator>
 #include <memory>
 #include <optional>
-#include <queue>
+#include <cstdint>
 #include <set>
 #include <utility>
 #include <vector>
 
 #include "cata_utility.h"
 #include "coordinates.h"
+#include "cuboid_rectangle.h"
 #include "debug.h"
 #include "game.h"
 #include "gates.h"
@@ -33,26 +34,33 @@ static constexpr int flat_index( const point &p )
     return ( p.x * MAPSIZE_Y ) + p.y;
 }
 
-// Flattened 2D array representing a single z-level worth of pathfinding data
+// Flattened 2D array representing a single z-level worth of pathfinding data.
+// A cell is only open or closed if its stamp matches the generation of the current search,
+// so nothing needs to be cleared between searches.
 struct path_data_layer {
     // Closed/open is accessed way more often than all other values here
-    std::bitset< MAPSIZE_X *MAPSIZE_Y > closed;
-    std::bitset< MAPSIZE_X *MAPSIZE_Y > open;
+    std::array< uint32_t, MAPSIZE_X *MAPSIZE_Y > closed;
+    std::array< uint32_t, MAPSIZE_X *MAPSIZE_Y > open;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
 
-    void reset() {
-        closed.reset();
-        open.reset();
+    path_data_layer() {
+        clear_stamps();
+    }
+
+    void clear_stamps() {
+        closed.fill( 0 );
+        open.fill( 0 );
     }
 };
 
 struct pathfinder {
-    using queue_type =
-        std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >;
-    queue_type open;
+    using queue_entry = std::pair<int, tripoint>;
+    // Used as a heap; kept around between searches so its storage is reused.
+    std::vector< queue_entry > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    uint32_t generation = 0;
 
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
@@ -63,14 +71,18 @@ struct pathfinder {
         return *ptr;
     }
 
-    void reset( int minz, int maxz ) {
-        for( int i = minz; i <= maxz; ++i ) {
-            std::unique_ptr< path_data_layer > &ptr = path_data[i + OVERMAP_DEPTH];
-            if( ptr != nullptr ) {
-                path_data[i + OVERMAP_DEPTH]->reset();
+    void reset() {
+        ++generation;
+        if( generation == 0 ) {
+            // Wrapped around, so old stamps could be mistaken for current ones
+            for( std::unique_ptr< path_data_layer > &ptr : path_data ) {
+                if( ptr != nullptr ) {
+                    ptr->clear_stamps();
+                }
             }
+            generation = 1;
         }
-        open = queue_type();
+        open.clear();
     }
 
     bool empty() const {
@@ -78,38 +90,44 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
+    }
+
+    bool is_closed( const path_data_layer &layer, const int index ) const {
+        return layer.closed[index] == generation;
+    }
+
+    void set_closed( path_data_layer &layer, const int index, const bool closed ) const {
+        layer.closed[index] = closed ? generation : 0;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         path_data_layer &layer = get_layer( to.z );
         const int index = flat_index( to.xy() );
-        if( layer.closed[index] ) {
+        if( is_closed( layer, index ) ) {
             return;
         }
-        if( layer.open[index] && gscore >= layer.gscore[index] ) {
+        if( layer.open[index] == generation && gscore >= layer.gscore[index] ) {
             return;
         }
 
-        layer.open[index] = true;
+        layer.open[index] = generation;
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.emplace( score, to );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
-        path_data_layer &layer = get_layer( p.z );
-        const int index = flat_index( p.xy() );
-        layer.closed[index] = true;
+        set_closed( get_layer( p.z ), flat_index( p.xy() ), true );
     }
 
     void unclose_point( const tripoint &p ) {
-        path_data_layer &layer = get_layer( p.z );
-        const int index = flat_index( p.xy() );
-        layer.closed[index] = false;
+        set_closed( get_layer( p.z ), flat_index( p.xy() ), false );
     }
 };
 
@@ -207,6 +225,8 @@ std::vector<tripoint_bub_ms> map::straight_route( const tripoint_bub_ms &f,
 }
 
 static constexpr int PF_IMPASSABLE = -1;
+// Routes longer than this are planned over submaps first
+static constexpr int hierarchical_route_min_dist = 2 * SEEX;
 static constexpr int PF_IMPASSABLE_FROM_HERE = -2;
 int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
                        const pathfinding_settings &settings,
@@ -404,7 +424,23 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
-    const int max_length = settings.max_length;
+    if( f.z == t.z && rl_dist( f, t ) > hierarchical_route_min_dist ) {
+        ret = route_hierarchical( f, t, settings, avoid );
+        if( !ret.empty() ) {
+            return ret;
+        }
+    }
+
+    int path_cost = 0;
+    return route_search( f, t, settings, settings.max_length, avoid, path_cost, nullptr );
+}
+
+std::vector<tripoint> map::route_search( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const int max_length,
+        const std::function<bool( const tripoint & )> &avoid, int &path_cost,
+        pathfinding_corridor *corridor ) const
+{
+    std::vector<tripoint> ret;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     tripoint min( std::min( f.x, t.x ) - pad, std::min( f.y, t.y ) - pad, std::min( f.z, t.z ) );
@@ -412,7 +448,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( min.x, min.y, min.z );
     clip_to_bounds( max.x, max.y, max.z );
 
-    pf.reset( min.z, max.z );
+    pf.reset();
 
     pf.add_point( 0, 0, f, f );
 
@@ -423,7 +459,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur.xy() );
         path_data_layer &layer = pf.get_layer( cur.z );
-        if( layer.closed[parent_index] ) {
+        if( pf.is_closed( layer, parent_index ) ) {
             continue;
         }
 
@@ -433,11 +469,12 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         }
 
         if( cur == t ) {
+            path_cost = layer.gscore[parent_index];
             done = true;
             break;
         }
 
-        layer.closed[parent_index] = true;
+        pf.set_closed( layer, parent_index, true );
 
         const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( cur.z );
         const PathfindingFlags cur_special = pf_cache.special[cur.x][cur.y];
@@ -456,12 +493,19 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
+            if( corridor != nullptr && !corridor->contains( p.xy() ) ) {
+                // No step is cheaper than the heuristic assumes, so p can't score less than this
+                corridor->min_pruned_score = std::min( corridor->min_pruned_score,
+                                                       layer.gscore[parent_index] + 2 * rl_dist( p, t ) );
+                continue;
+            }
+
             if( p != t && avoid( p ) ) {
-                layer.closed[index] = true;
+                pf.set_closed( layer, index, true );
                 continue;
             }
 
-            if( layer.closed[index] ) {
+            if( pf.is_closed( layer, index ) ) {
                 continue;
             }
 
@@ -472,7 +516,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             const int cost = extra_cost( tripoint_bub_ms( cur ), tripoint_bub_ms( p ), settings, p_special );
             if( cost < 0 ) {
                 if( cost == PF_IMPASSABLE ) {
-                    layer.closed[index] = true;
+                    pf.set_closed( layer, index, true );
                 }
                 continue;
             }
@@ -500,7 +544,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         }
 
                         // Close p, because we won't be walking on it
-                        layer.closed[index] = true;
+                        pf.set_closed( layer, index, true );
                         continue;
                     }
                 }
@@ -627,6 +671,163 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     return ret;
 }
 
+// Tiles that any pathfinder can cross at the flat ground cost
+static constexpr PathfindingFlags non_plain = PathfindingFlag::Slow | PathfindingFlag::Obstacle |
+        PathfindingFlag::Vehicle | PathfindingFlag::DangerousTrap | PathfindingFlag::Sharp |
+        PathfindingFlag::DangerousField;
+
+// Returns the offset of the middle of the longest run of offsets along a submap border
+// for which |crossable| is true, or no_crossing if there is none.
+template<typename Crossable>
+static int8_t widest_crossing( const Crossable &crossable )
+{
+    int best_start = 0;
+    int best_length = 0;
+    int run_start = 0;
+    int run_length = 0;
+    for( int i = 0; i < SEEX; ++i ) {
+        if( !crossable( i ) ) {
+            run_length = 0;
+            continue;
+        }
+        if( run_length == 0 ) {
+            run_start = i;
+        }
+        ++run_length;
+        if( run_length > best_length ) {
+            best_start = run_start;
+            best_length = run_length;
+        }
+    }
+    if( best_length == 0 ) {
+        return pathfinding_abstract_graph::no_crossing;
+    }
+    return static_cast<int8_t>( best_start + best_length / 2 );
+}
+
+static constexpr int abstract_index( const point &sm )
+{
+    return sm.x * MAPSIZE + sm.y;
+}
+
+void pathfinding_cache::update_abstract_graph( const int mapsize )
+{
+    if( abstract.dirty.none() ) {
+        return;
+    }
+    const auto plain = [this]( const int x, const int y ) {
+        return !( special[x][y] & non_plain );
+    };
+    for( int smx = 0; smx < mapsize; ++smx ) {
+        for( int smy = 0; smy < mapsize; ++smy ) {
+            const point sm( smx, smy );
+            const int index = abstract_index( sm );
+            // A submap's crossings also depend on its east and south neighbours
+            const bool east_dirty = smx + 1 < mapsize && abstract.dirty[abstract_index( sm + point_east )];
+            const bool south_dirty = smy + 1 < mapsize &&
+                                     abstract.dirty[abstract_index( sm + point_south )];
+            if( !abstract.dirty[index] && !east_dirty && !south_dirty ) {
+                continue;
+            }
+            const point origin( smx * SEEX, smy * SEEY );
+            abstract.east_crossing[index] = smx + 1 >= mapsize ? pathfinding_abstract_graph::no_crossing :
+            widest_crossing( [&]( const int i ) {
+                return plain( origin.x + SEEX - 1, origin.y + i ) && plain( origin.x + SEEX, origin.y + i );
+            } );
+            abstract.south_crossing[index] = smy + 1 >= mapsize ? pathfinding_abstract_graph::no_crossing :
+            widest_crossing( [&]( const int i ) {
+                return plain( origin.x + i, origin.y + SEEY - 1 ) && plain( origin.x + i, origin.y + SEEY );
+            } );
+        }
+    }
+    abstract.dirty.reset();
+}
+
+// Breadth-first search over submaps connected by crossings. Returns the submaps on the way
+// from the submap of |f| to the submap of |t|, both included, or nothing if there is no way.
+static std::vector<point> abstract_route( const pathfinding_abstract_graph &graph,
+        const int mapsize, const tripoint &f, const tripoint &t )
+{
+    std::vector<point> ret;
+    const point from( f.x / SEEX, f.y / SEEY );
+    const point to( t.x / SEEX, t.y / SEEY );
+    if( from == to ) {
+        return ret;
+    }
+
+    // Searching backwards from the destination lets us read the route off |next| in order
+    std::array<int16_t, MAPSIZE *MAPSIZE> next;
+    next.fill( -1 );
+    next[abstract_index( to )] = static_cast<int16_t>( abstract_index( to ) );
+    std::vector<point> frontier;
+    frontier.reserve( static_cast<size_t>( mapsize * mapsize ) );
+    frontier.push_back( to );
+    const half_open_rectangle<point> bounds( point_zero, point( mapsize, mapsize ) );
+    for( size_t i = 0; i < frontier.size() && next[abstract_index( from )] < 0; ++i ) {
+        const point cur = frontier[i];
+        const int cur_index = abstract_index( cur );
+        for( const point &d : four_adjacent_offsets ) {
+            const point neighbour = cur + d;
+            if( !bounds.contains( neighbour ) || next[abstract_index( neighbour )] >= 0 ) {
+                continue;
+            }
+            // Crossings are stored on the west/north submap of each pair
+            const bool crossable = d.x != 0 ?
+                                   graph.east_crossing[abstract_index( d.x > 0 ? cur : neighbour )] >= 0 :
+                                   graph.south_crossing[abstract_index( d.y > 0 ? cur : neighbour )] >= 0;
+            if( crossable ) {
+                next[abstract_index( neighbour )] = static_cast<int16_t>( cur_index );
+                frontier.push_back( neighbour );
+            }
+        }
+    }
+    if( next[abstract_index( from )] < 0 ) {
+        return ret;
+    }
+
+    for( point cur = from; cur != to; ) {
+        ret.push_back( cur );
+        const int following = next[abstract_index( cur )];
+        cur = point( following / MAPSIZE, following % MAPSIZE );
+    }
+    ret.push_back( to );
+    return ret;
+}
+
+std::vector<tripoint> map::route_hierarchical( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings,
+        const std::function<bool( const tripoint & )> &avoid ) const
+{
+    // Brings the tile cache up to date before the abstract graph is built from it
+    get_pathfinding_cache_ref( f.z );
+    pathfinding_cache &cache = get_pathfinding_cache( f.z );
+    cache.update_abstract_graph( my_MAPSIZE );
+    const std::vector<point> submaps = abstract_route( cache.abstract, my_MAPSIZE, f, t );
+    if( submaps.empty() ) {
+        return std::vector<tripoint>();
+    }
+
+    // The submaps on the way and those around them, so that diagonal shortcuts fit
+    pathfinding_corridor corridor;
+    const half_open_rectangle<point> bounds( point_zero, point( my_MAPSIZE, my_MAPSIZE ) );
+    for( const point &sm : submaps ) {
+        for( const point &p : closest_points_first( sm, 1 ) ) {
+            if( bounds.contains( p ) ) {
+                corridor.submaps.set( abstract_index( p ) );
+            }
+        }
+    }
+
+    int cost = 0;
+    std::vector<tripoint> ret = route_search( f, t, settings, settings.max_length, avoid, cost,
+                                &corridor );
+    // The full search would only have found a cheaper route through a tile left out here
+    if( ret.empty() || corridor.min_pruned_score < cost ) {
+        return std::vector<tripoint>();
+    }
+    return ret;
+}
+
 std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f, const tripoint_bub_ms &t,
         const pathfinding_settings &settings,
         const std::function<bool( const tripoint & )> &avoid ) const
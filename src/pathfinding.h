@@ -2,9 +2,16 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <unordered_set>
+
 #include "coords_fwd.h"
 #include "game_constants.h"
 #include "mdarray.h"
+#include "point.h"
 
 // An attribute of a particular map square that is of interest in pathfinding.
 // Has a maximum of 32 members. For more, the datatype underlying PathfindingFlags
@@ -119,6 +126,31 @@ constexpr PathfindingFlags operator |( const PathfindingFlag &a, const Pathfindi
     return PathfindingFlags( a ) | PathfindingFlags( b );
 }
 
+// Submap-level summary of a pathfinding_cache, used to plan long routes before refining them
+// tile by tile. Each submap stores where plain ground crosses into its east and south neighbour.
+struct pathfinding_abstract_graph {
+    static constexpr int8_t no_crossing = -1;
+
+    // Offset along the shared border of the middle of the widest crossing, or no_crossing.
+    // Indexed by submap x * MAPSIZE + submap y.
+    std::array<int8_t, MAPSIZE *MAPSIZE> east_crossing;
+    std::array<int8_t, MAPSIZE *MAPSIZE> south_crossing;
+    // Submaps whose tiles changed since the crossings were computed
+    std::bitset<MAPSIZE *MAPSIZE> dirty;
+};
+
+// Submaps a route search is kept to. The search remembers the lowest score of the tiles it
+// left out, a route that costs no more than that is as cheap as the unrestricted search's.
+struct pathfinding_corridor {
+    // Indexed like pathfinding_abstract_graph
+    std::bitset<MAPSIZE *MAPSIZE> submaps;
+    int min_pruned_score = INT_MAX;
+
+    bool contains( const point &p ) const {
+        return submaps[( p.x / SEEX ) * MAPSIZE + p.y / SEEY];
+    }
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
 
@@ -126,6 +158,11 @@ struct pathfinding_cache {
     std::unordered_set<point> dirty_points;
 
     cata::mdarray<PathfindingFlags, point_bub_ms> special;
+
+    pathfinding_abstract_graph abstract;
+
+    // Recomputes the crossings around dirty submaps from @ref special, which must be up to date.
+    void update_abstract_graph( int mapsize );
 };
 
 struct pathfinding_settings {
@@ -0,0 +1,275 @@
+#include "profiling.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "json.h"
+#include "string_formatter.h"
+
+namespace profiling
+{
+
+namespace detail
+{
+std::atomic<bool> enabled_flag( false );
+} // namespace detail
+
+namespace
+{
+
+using profile_clock = std::chrono::steady_clock;
+
+// Enough for a few minutes of busy turns
+constexpr size_t max_trace_events = 200000;
+
+struct turn_totals {
+    std::array<profile_clock::duration, num_zones> time{};
+    std::array<int, num_zones> calls{};
+    int turn = 0;
+};
+
+struct trace_event {
+    zone z;
+    int thread;
+    profile_clock::time_point start;
+    profile_clock::duration duration;
+};
+
+struct profiler_state {
+    std::mutex mutex;
+    turn_totals current;
+    std::deque<turn_totals> window;
+    std::deque<trace_event> events;
+    int turns_closed = 0;
+    profile_clock::time_point epoch = profile_clock::now();
+    std::map<std::thread::id, int> thread_numbers;
+};
+
+profiler_state &state()
+{
+    static profiler_state instance;
+    return instance;
+}
+
+std::chrono::microseconds to_us( profile_clock::duration d )
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d );
+}
+
+} // namespace
+
+const char *zone_name( zone z )
+{
+    switch( z ) {
+        // *INDENT-OFF*
+        case zone::do_turn: return "do_turn";
+        case zone::player_actions: return "player_actions";
+        case zone::monmove: return "monmove";
+        case zone::process_fields: return "process_fields";
+        case zone::process_items: return "process_items";
+        case zone::build_map_cache: return "build_map_cache";
+        case zone::process_sounds: return "process_sounds";
+        // *INDENT-ON*
+        case zone::num_zones:
+            break;
+    }
+    return "unknown";
+}
+
+void detail::record( zone z, profile_clock::time_point start, profile_clock::time_point end )
+{
+    profiler_state &s = state();
+    const std::thread::id thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock( s.mutex );
+    const int i = static_cast<int>( z );
+    s.current.time[i] += end - start;
+    ++s.current.calls[i];
+    const auto number = s.thread_numbers.emplace( thread, static_cast<int>( s.thread_numbers.size() ) );
+    s.events.push_back( { z, number.first->second, start, end - start } );
+    if( s.events.size() > max_trace_events ) {
+        s.events.pop_front();
+    }
+}
+
+void set_enabled( bool enable )
+{
+    profiler_state &s = state();
+    {
+        std::lock_guard<std::mutex> lock( s.mutex );
+        if( enable && !enabled() ) {
+            s.current = turn_totals();
+            s.window.clear();
+            s.events.clear();
+            s.turns_closed = 0;
+            s.epoch = profile_clock::now();
+        }
+    }
+    detail::enabled_flag.store( enable, std::memory_order_relaxed );
+}
+
+scoped_turn::scoped_turn()
+{
+    if( enabled() ) {
+        active = true;
+        start = profile_clock::now();
+    }
+}
+
+scoped_turn::~scoped_turn()
+{
+    if( active ) {
+        detail::record( zone::do_turn, start, profile_clock::now() );
+        end_turn();
+    }
+}
+
+void end_turn()
+{
+    profiler_state &s = state();
+    std::lock_guard<std::mutex> lock( s.mutex );
+    s.current.turn = s.turns_closed++;
+    s.window.push_back( s.current );
+    if( s.window.size() > static_cast<size_t>( window_turns ) ) {
+        s.window.pop_front();
+    }
+    s.current = turn_totals();
+}
+
+std::vector<zone_summary> summarize()
+{
+    std::deque<turn_totals> window;
+    {
+        profiler_state &s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        window = s.window;
+    }
+
+    std::vector<zone_summary> result;
+    for( int i = 0; i < num_zones; ++i ) {
+        zone_summary summary;
+        summary.z = static_cast<zone>( i );
+        std::vector<profile_clock::duration> times;
+        int calls = 0;
+        for( const turn_totals &turn : window ) {
+            calls += turn.calls[i];
+            if( turn.calls[i] > 0 ) {
+                times.push_back( turn.time[i] );
+            }
+        }
+        if( times.empty() ) {
+            result.push_back( summary );
+            continue;
+        }
+        summary.turns = static_cast<int>( times.size() );
+        summary.calls_per_turn = static_cast<double>( calls ) / window.size();
+        summary.last = to_us( window.back().time[i] );
+        profile_clock::duration total{};
+        for( const profile_clock::duration &t : times ) {
+            total += t;
+            const std::chrono::microseconds us = to_us( t );
+            const auto bucket = std::find_if( histogram_bounds.begin(), histogram_bounds.end(),
+            [&us]( int bound ) {
+                return us.count() < bound;
+            } );
+            ++summary.histogram[bucket - histogram_bounds.begin()];
+        }
+        std::sort( times.begin(), times.end() );
+        summary.mean = to_us( total / times.size() );
+        summary.median = to_us( times[times.size() / 2] );
+        summary.p95 = to_us( times[std::min( times.size() - 1, times.size() * 95 / 100 )] );
+        summary.max = to_us( times.back() );
+        result.push_back( summary );
+    }
+    return result;
+}
+
+std::string report()
+{
+    const std::vector<zone_summary> summaries = summarize();
+    int turns = 0;
+    {
+        profiler_state &s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        turns = static_cast<int>( s.window.size() );
+    }
+    std::string result = string_format( "Last %d turns, times in microseconds per turn\n\n", turns );
+    result += string_format( "%-16s %6s %9s %9s %9s %9s %9s  %s\n", "zone", "calls", "last", "mean",
+                             "median", "p95", "max", "turns <0.1ms <1ms <10ms <100ms <1s >=1s" );
+    for( const zone_summary &summary : summaries ) {
+        std::string histogram;
+        for( const int count : summary.histogram ) {
+            histogram += string_format( " %d", count );
+        }
+        result += string_format( "%-16s %6.1f %9d %9d %9d %9d %9d %s\n", zone_name( summary.z ),
+                                 summary.calls_per_turn, summary.last.count(), summary.mean.count(),
+                                 summary.median.count(), summary.p95.count(), summary.max.count(),
+                                 histogram );
+    }
+    return result;
+}
+
+bool write_csv( const cata_path &path )
+{
+    std::deque<turn_totals> window;
+    {
+        profiler_state &s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        window = s.window;
+    }
+    return write_to_file( path, [&window]( std::ostream & out ) {
+        out << "turn";
+        for( int i = 0; i < num_zones; ++i ) {
+            const char *name = zone_name( static_cast<zone>( i ) );
+            out << "," << name << "_calls," << name << "_us";
+        }
+        out << "\n";
+        for( const turn_totals &turn : window ) {
+            out << turn.turn;
+            for( int i = 0; i < num_zones; ++i ) {
+                out << "," << turn.calls[i] << "," << to_us( turn.time[i] ).count();
+            }
+            out << "\n";
+        }
+    }, "turn profile" );
+}
+
+bool write_chrome_trace( const cata_path &path )
+{
+    std::deque<trace_event> events;
+    profile_clock::time_point epoch;
+    {
+        profiler_state &s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        events = s.events;
+        epoch = s.epoch;
+    }
+    return write_to_file( path, [&]( std::ostream & out ) {
+        using micros = std::chrono::duration<double, std::micro>;
+        JsonOut jsout( out );
+        jsout.start_object();
+        jsout.member( "displayTimeUnit", "ms" );
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const trace_event &e : events ) {
+            jsout.start_object();
+            jsout.member( "name", zone_name( e.z ) );
+            jsout.member( "ph", "X" );
+            jsout.member( "ts", micros( e.start - epoch ).count() );
+            jsout.member( "dur", micros( e.duration ).count() );
+            jsout.member( "pid", 1 );
+            jsout.member( "tid", e.thread );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "turn profile trace" );
+}
+
+} // namespace profiling
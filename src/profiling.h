@@ -0,0 +1,128 @@
+#pragma once
+#ifndef CATA_SRC_PROFILING_H
+#define CATA_SRC_PROFILING_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+class cata_path;
+
+/**
+ * Timing of the hot parts of a turn.
+ *
+ * Code to be measured opens a @ref profiling::scoped_zone for its scope. While profiling is off
+ * this costs one relaxed atomic load. While on, the time spent in every zone is summed up per
+ * turn, and the last @ref profiling::window_turns turns are kept for the report. The individual
+ * zone timings are kept too, so that they can be written out as a Chrome trace.
+ *
+ * Zones may be opened from worker threads.
+ */
+namespace profiling
+{
+
+enum class zone : int {
+    do_turn,
+    player_actions,
+    monmove,
+    process_fields,
+    process_items,
+    build_map_cache,
+    process_sounds,
+    num_zones
+};
+
+constexpr int num_zones = static_cast<int>( zone::num_zones );
+
+/** Number of turns kept for the report and the CSV. */
+constexpr int window_turns = 600;
+
+/** Upper bounds of the histogram buckets in microseconds; the last bucket is unbounded. */
+constexpr std::array<int, 5> histogram_bounds = { { 100, 1000, 10000, 100000, 1000000 } };
+
+const char *zone_name( zone z );
+
+namespace detail
+{
+extern std::atomic<bool> enabled_flag;
+void record( zone z, std::chrono::steady_clock::time_point start,
+             std::chrono::steady_clock::time_point end );
+} // namespace detail
+
+inline bool enabled()
+{
+    return detail::enabled_flag.load( std::memory_order_relaxed );
+}
+
+/** Turns profiling on or off. Turning it on drops anything collected before. */
+void set_enabled( bool enable );
+
+class scoped_zone
+{
+    public:
+        explicit scoped_zone( zone z ) : z( z ) {
+            if( enabled() ) {
+                active = true;
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        scoped_zone( const scoped_zone & ) = delete;
+        scoped_zone &operator=( const scoped_zone & ) = delete;
+        ~scoped_zone() {
+            if( active ) {
+                detail::record( z, start, std::chrono::steady_clock::now() );
+            }
+        }
+
+    private:
+        zone z;
+        bool active = false;
+        std::chrono::steady_clock::time_point start;
+};
+
+/** Like @ref scoped_zone for @ref zone::do_turn, and closes the turn when it ends. */
+class scoped_turn
+{
+    public:
+        scoped_turn();
+        scoped_turn( const scoped_turn & ) = delete;
+        scoped_turn &operator=( const scoped_turn & ) = delete;
+        ~scoped_turn();
+
+    private:
+        bool active = false;
+        std::chrono::steady_clock::time_point start;
+};
+
+/** Moves the zone timings collected since the last call into the rolling window. */
+void end_turn();
+
+struct zone_summary {
+    zone z;
+    /** Turns in the window in which the zone was entered at all. */
+    int turns = 0;
+    double calls_per_turn = 0.0;
+    std::chrono::microseconds mean{ 0 };
+    std::chrono::microseconds median{ 0 };
+    std::chrono::microseconds p95{ 0 };
+    std::chrono::microseconds max{ 0 };
+    std::chrono::microseconds last{ 0 };
+    /** Turns per bucket of @ref histogram_bounds, plus one for anything above the last bound. */
+    std::array<int, histogram_bounds.size() + 1> histogram{};
+};
+
+/** Per-zone statistics over the turns in the window. */
+std::vector<zone_summary> summarize();
+/** @ref summarize as a text table. */
+std::string report();
+
+/** Writes the per-turn zone totals in the window, one row per turn. */
+bool write_csv( const cata_path &path );
+/** Writes every zone timing still held as a Chrome trace (chrome://tracing or Perfetto). */
+bool write_chrome_trace( const cata_path &path );
+
+} // namespace profiling
+
+#endif // CATA_SRC_PROFILING_H
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 
@@ -20,6 +21,7 @@
 #include "mapgen.h"
 #include "mod_manager.h"
 #include "output.h"
+#include "recipe_search_index.h"
 #include "requirements.h"
 #include "skill.h"
 #include "uistate.h"
@@ -166,6 +168,25 @@ std::vector<const recipe *> recipe_subset::recent() const
     return res;
 }
 
+static std::optional<recipe_search_index::field> search_index_field(
+    const recipe_subset::search_type key )
+{
+    switch( key ) {
+        case recipe_subset::search_type::name:
+        case recipe_subset::search_type::exclude_name:
+            return recipe_search_index::field::name;
+        case recipe_subset::search_type::skill:
+        case recipe_subset::search_type::primary_skill:
+            return recipe_search_index::field::skill;
+        case recipe_subset::search_type::component:
+            return recipe_search_index::field::component;
+        case recipe_subset::search_type::tool:
+            return recipe_search_index::field::tool;
+        default:
+            return std::nullopt;
+    }
+}
+
 std::vector<const recipe *> recipe_subset::search(
     const std::string_view txt, const search_type key,
     const std::function<void( size_t, size_t )> &progress_callback ) const
@@ -283,13 +304,36 @@ std::vector<const recipe *> recipe_subset::search(
         }
     };
 
+    std::optional<std::vector<const recipe *>> candidates;
+    if( const std::optional<recipe_search_index::field> field = search_index_field( key ) ) {
+        candidates = get_recipe_search_index().candidates( *field, txt, recipes );
+    }
+
     std::vector<const recipe *> res;
     size_t i = 0;
+    if( candidates && key != search_type::exclude_name ) {
+        // Only the candidates can match, no need to look at the rest
+        for( const recipe *r : *candidates ) {
+            if( progress_callback ) {
+                progress_callback( i, candidates->size() );
+            }
+            if( predicate( r ) ) {
+                res.push_back( r );
+            }
+            ++i;
+        }
+        return res;
+    }
     for( const recipe *r : recipes ) {
         if( progress_callback ) {
             progress_callback( i, recipes.size() );
         }
-        if( predicate( r ) ) {
+        if( candidates && !std::binary_search( candidates->begin(), candidates->end(), r ) ) {
+            // Can't match the name, so it isn't excluded
+            if( *r && !r->obsolete ) {
+                res.push_back( r );
+            }
+        } else if( predicate( r ) ) {
             res.push_back( r );
         }
         ++i;
@@ -714,6 +758,7 @@ void recipe_dictionary::check_consistency()
 
 void recipe_dictionary::reset()
 {
+    get_recipe_search_index().clear();
     recipe_dict.blueprints.clear();
     recipe_dict.autolearn.clear();
     recipe_dict.nested.clear();
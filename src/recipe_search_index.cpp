@@ -0,0 +1,161 @@
+#include "recipe_search_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "cached_options.h"
+#include "catacharset.h"
+#include "item.h"
+#include "recipe.h"
+#include "requirements.h"
+#include "skill.h"
+#include "translation_cache.h"
+#include "type_id.h"
+#include "unicode.h"
+
+// Code points take up to 21 bits, three of them fit into one key
+static uint64_t trigram_key( const char32_t *first )
+{
+    return static_cast<uint64_t>( first[0] ) << 42 | static_cast<uint64_t>( first[1] ) << 21 |
+           static_cast<uint64_t>( first[2] );
+}
+
+static void add_trigrams( const std::u32string &text, std::unordered_set<uint64_t> &keys )
+{
+    for( size_t i = 0; i + 3 <= text.size(); ++i ) {
+        keys.insert( trigram_key( &text[i] ) );
+    }
+}
+
+// Adds the trigrams of every form of the text lcmatch() looks for the query in
+static void add_text( const std::string &text, std::unordered_set<uint64_t> &keys )
+{
+    std::u32string u32_text = utf8_to_utf32( text );
+    std::for_each( u32_text.begin(), u32_text.end(), u32_to_lowercase );
+    add_trigrams( u32_text, keys );
+    std::for_each( u32_text.begin(), u32_text.end(), remove_accent );
+    add_trigrams( u32_text, keys );
+}
+
+// The same texts recipe_subset::search matches queries against
+static void add_field( const recipe &r, const recipe_search_index::field f,
+                       std::unordered_set<uint64_t> &keys )
+{
+    switch( f ) {
+        case recipe_search_index::field::name:
+            add_text( r.result_name(), keys );
+            break;
+        case recipe_search_index::field::skill:
+            add_text( r.skill_used->name(), keys );
+            for( const std::pair<const skill_id, int> &skill : r.required_skills ) {
+                add_text( skill.first->name(), keys );
+            }
+            break;
+        case recipe_search_index::field::component:
+            for( const std::vector<item_comp> &options : r.simple_requirements().get_components() ) {
+                for( const item_comp &comp : options ) {
+                    add_text( item::nname( comp.type ), keys );
+                }
+            }
+            break;
+        case recipe_search_index::field::tool:
+            for( const std::vector<tool_comp> &options : r.simple_requirements().get_tools() ) {
+                for( const tool_comp &tool : options ) {
+                    add_text( tool.to_string(), keys );
+                }
+            }
+            break;
+        case recipe_search_index::field::num_fields:
+            break;
+    }
+}
+
+void recipe_search_index::index( const recipe *r )
+{
+    std::unordered_set<uint64_t> keys;
+    for( size_t f = 0; f < postings.size(); ++f ) {
+        keys.clear();
+        add_field( *r, static_cast<field>( f ), keys );
+        for( const uint64_t key : keys ) {
+            postings[f][key].push_back( r );
+        }
+    }
+}
+
+std::optional<std::vector<const recipe *>> recipe_search_index::candidates(
+            const field f, const std::string_view query, const std::set<const recipe *> &recipes )
+{
+    if( use_pinyin_search ) {
+        // Pinyin matches don't share trigrams with the text
+        return std::nullopt;
+    }
+    std::u32string u32_query = utf8_to_utf32( query );
+    if( u32_query.size() < 3 ) {
+        return std::nullopt;
+    }
+    std::for_each( u32_query.begin(), u32_query.end(), u32_to_lowercase );
+
+    if( language_version != detail::get_current_language_version() ) {
+        clear();
+        language_version = detail::get_current_language_version();
+    }
+    bool added = false;
+    for( const recipe *r : recipes ) {
+        if( indexed.insert( r ).second ) {
+            index( r );
+            added = true;
+        }
+    }
+    if( added ) {
+        // The posting lists are kept in the same order as the recipe sets, by address
+        for( std::unordered_map<uint64_t, posting_list> &lists : postings ) {
+            for( std::pair<const uint64_t, posting_list> &list : lists ) {
+                std::sort( list.second.begin(), list.second.end() );
+            }
+        }
+    }
+
+    std::vector<const posting_list *> query_lists;
+    const std::unordered_map<uint64_t, posting_list> &lists = postings[static_cast<size_t>( f )];
+    for( size_t i = 0; i + 3 <= u32_query.size(); ++i ) {
+        const auto iter = lists.find( trigram_key( &u32_query[i] ) );
+        if( iter == lists.end() ) {
+            return std::vector<const recipe *>();
+        }
+        query_lists.push_back( &iter->second );
+    }
+    // Start from the rarest trigram, the intersection can only get smaller
+    std::sort( query_lists.begin(), query_lists.end(),
+    []( const posting_list * lhs, const posting_list * rhs ) {
+        return lhs->size() < rhs->size();
+    } );
+
+    std::vector<const recipe *> result;
+    std::set_intersection( query_lists.front()->begin(), query_lists.front()->end(),
+                           recipes.begin(), recipes.end(), std::back_inserter( result ) );
+    std::vector<const recipe *> narrowed;
+    for( size_t i = 1; i < query_lists.size() && !result.empty(); ++i ) {
+        narrowed.clear();
+        std::set_intersection( result.begin(), result.end(), query_lists[i]->begin(),
+                               query_lists[i]->end(), std::back_inserter( narrowed ) );
+        result.swap( narrowed );
+    }
+    return result;
+}
+
+void recipe_search_index::clear()
+{
+    for( std::unordered_map<uint64_t, posting_list> &lists : postings ) {
+        lists.clear();
+    }
+    indexed.clear();
+}
+
+recipe_search_index &get_recipe_search_index()
+{
+    static recipe_search_index index;
+    return index;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef CATA_SRC_RECIPE_SEARCH_INDEX_H
+#define CATA_SRC_RECIPE_SEARCH_INDEX_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "translation_cache.h"
+
+class recipe;
+
+/**
+ * Trigram index over the translated texts recipe_subset::search matches queries against.
+ *
+ * Every recipe is indexed by the trigrams of the lowercase forms of its texts, with and without
+ * accents, so a recipe that lcmatch() would match always has all trigrams of the query. The
+ * index only narrows the recipes down, the candidates still have to be matched exactly.
+ *
+ * Recipes are indexed the first time they are searched. The index is dropped when the language
+ * changes and when the recipes are reloaded.
+ */
+class recipe_search_index
+{
+    public:
+        enum class field : int {
+            name,
+            // Primary and required skills
+            skill,
+            component,
+            tool,
+            num_fields
+        };
+
+        /**
+         * Recipes among @p recipes that may match @p query in @p f, in the order of @p recipes.
+         * Returns std::nullopt if the query is too short to narrow anything down.
+         */
+        std::optional<std::vector<const recipe *>> candidates(
+                    field f, std::string_view query, const std::set<const recipe *> &recipes );
+
+        void clear();
+
+    private:
+        using posting_list = std::vector<const recipe *>;
+
+        void index( const recipe *r );
+
+        std::array < std::unordered_map<uint64_t, posting_list>,
+            static_cast<size_t>( field::num_fields ) > postings;
+        std::unordered_set<const recipe *> indexed;
+        int language_version = INVALID_LANGUAGE_VERSION;
+};
+
+recipe_search_index &get_recipe_search_index();
+
+#endif // CATA_SRC_RECIPE_SEARCH_INDEX_H
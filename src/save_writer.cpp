@@ -0,0 +1,156 @@
+#include "save_writer.h"
+
+#include <exception>
+#include <ios>
+#include <memory>
+#include <utility>
+
+#include "ofstream_wrapper.h"
+#include "output.h"
+#include "translations.h"
+
+namespace cata
+{
+
+save_writer::~save_writer()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    job_available.notify_all();
+    if( thread.joinable() ) {
+        thread.join();
+    }
+}
+
+void save_writer::write( const fs::path &path, std::string contents )
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    if( !thread.joinable() ) {
+        thread = std::thread( &save_writer::writer_loop, this );
+    }
+    // Always let one job through, however big it is
+    job_done.wait( lock, [this] {
+        return queued_bytes < max_queued_bytes || queue.empty();
+    } );
+    queued_bytes += contents.size();
+    ++pending[path.lexically_normal()];
+    ++pending_jobs;
+    queue.push_back( { path, std::move( contents ) } );
+    lock.unlock();
+    job_available.notify_one();
+}
+
+bool save_writer::is_queued( const fs::path &path )
+{
+    if( pending_jobs == 0 ) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock( mutex );
+    return pending.count( path.lexically_normal() ) > 0;
+}
+
+void save_writer::wait_for( const fs::path &path )
+{
+    if( pending_jobs == 0 ) {
+        return;
+    }
+    const fs::path key = path.lexically_normal();
+    std::unique_lock<std::mutex> lock( mutex );
+    job_done.wait( lock, [&] {
+        return pending.count( key ) == 0;
+    } );
+}
+
+void save_writer::flush()
+{
+    if( pending_jobs == 0 ) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock( mutex );
+    job_done.wait( lock, [this] {
+        return pending.empty();
+    } );
+}
+
+std::vector<std::pair<std::string, std::string>> save_writer::take_errors()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return std::exchange( errors, {} );
+}
+
+void save_writer::writer_loop()
+{
+    while( true ) {
+        std::unique_lock<std::mutex> lock( mutex );
+        job_available.wait( lock, [this] {
+            return stopping || !queue.empty();
+        } );
+        // Drain the queue before stopping, so nothing queued is lost.
+        if( queue.empty() ) {
+            return;
+        }
+        // The job stays queued while it is written, so that the path counts as pending
+        // and the writes to it happen in order.
+        job &next = queue.front();
+        lock.unlock();
+
+        // Translating is not safe here, the message is put together by the main thread
+        std::string error;
+        try {
+            ofstream_wrapper fout( next.path, std::ios::binary );
+            fout.stream().write( next.contents.data(), next.contents.size() );
+            fout.close();
+        } catch( const std::exception &err ) {
+            error = err.what();
+        }
+
+        lock.lock();
+        if( !error.empty() ) {
+            errors.emplace_back( next.path.generic_u8string(), error );
+        }
+        const auto iter = pending.find( next.path.lexically_normal() );
+        if( --iter->second == 0 ) {
+            pending.erase( iter );
+        }
+        --pending_jobs;
+        queued_bytes -= next.contents.size();
+        queue.pop_front();
+        lock.unlock();
+        job_done.notify_all();
+    }
+}
+
+// Only the main thread saves, so this does not need to be per thread.
+static int deferred_depth = 0;
+
+deferred_saves::deferred_saves()
+{
+    ++deferred_depth;
+}
+
+deferred_saves::~deferred_saves()
+{
+    --deferred_depth;
+}
+
+bool deferred_saves::active()
+{
+    return deferred_depth > 0;
+}
+
+} // namespace cata
+
+cata::save_writer &get_save_writer()
+{
+    static cata::save_writer writer;
+    return writer;
+}
+
+void report_background_save_errors()
+{
+    for( const std::pair<std::string, std::string> &error : get_save_writer().take_errors() ) {
+        popup( _( "Failed to write \"%1$s\": %2$s" ), error.first, error.second );
+    }
+}
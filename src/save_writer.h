@@ -0,0 +1,101 @@
+#pragma once
+#ifndef CATA_SRC_SAVE_WRITER_H
+#define CATA_SRC_SAVE_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "filesystem.h"
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+namespace cata
+{
+
+/**
+ * Writes already serialized save files on a background thread.
+ *
+ * Files are written in the order they were queued, through a temporary file that is renamed
+ * into place, like @ref write_to_file does. Anything that reads or writes a file directly
+ * must first call @ref wait_for on it, so that it does not see or overwrite an older version
+ * of the file that is still queued. @ref read_from_file and friends do this on their own.
+ */
+class save_writer
+{
+    public:
+        /** Queuing more than this blocks until the writes have caught up. */
+        static constexpr size_t max_queued_bytes = 64 * 1024 * 1024;
+
+        save_writer() = default;
+        save_writer( const save_writer & ) = delete;
+        save_writer &operator=( const save_writer & ) = delete;
+        /** Finishes all queued writes. */
+        ~save_writer();
+
+        /** Queues @p contents to be written to @p path. */
+        void write( const fs::path &path, std::string contents );
+        /** Whether a write to @p path is queued or in progress. */
+        bool is_queued( const fs::path &path );
+        /** Blocks until every queued write to @p path has finished. */
+        void wait_for( const fs::path &path );
+        /** Blocks until every queued write has finished. */
+        void flush();
+        /** Paths and error messages of the writes that failed since the last call. */
+        std::vector<std::pair<std::string, std::string>> take_errors();
+
+    private:
+        struct job {
+            fs::path path;
+            std::string contents;
+        };
+
+        void writer_loop();
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable job_available;
+        std::condition_variable job_done;
+        std::deque<job> queue;
+        // Queued or in progress writes per path
+        std::map<fs::path, int> pending;
+        // Number of queued or in progress writes, for checking without the lock
+        std::atomic<size_t> pending_jobs{ 0 };
+        size_t queued_bytes = 0;
+        bool stopping = false;
+        std::vector<std::pair<std::string, std::string>> errors;
+};
+
+/**
+ * While an instance of this exists, @ref write_to_file only serializes the file and queues
+ * it on the save writer instead of writing it. Only meant for the main thread.
+ */
+class deferred_saves
+{
+    public:
+        deferred_saves();
+        deferred_saves( const deferred_saves & ) = delete;
+        deferred_saves &operator=( const deferred_saves & ) = delete;
+        ~deferred_saves();
+
+        /** Whether writes are currently being queued. */
+        static bool active();
+};
+
+} // namespace cata
+
+cata::save_writer &get_save_writer();
+
+/** Shows a popup for every background write that failed since the last call. */
+void report_background_save_errors();
+
+#endif // CATA_SRC_SAVE_WRITER_H
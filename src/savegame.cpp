@@ -410,6 +410,8 @@ void overmap::unserialize( const cata_path &file_name, std::istream &fin )
 
 void overmap::unserialize( const JsonObject &jsobj )
 {
+    // Terrain and special placements are written directly below
+    invalidate_indices();
     // These must be read in this order.
     if( jsobj.has_member( "mapgen_arg_storage" ) ) {
         jsobj.read( "mapgen_arg_storage", mapgen_arg_storage, true );
@@ -751,6 +753,7 @@ void overmap::unserialize( const JsonObject &jsobj )
 // throws std::exception
 void overmap::unserialize_omap( const JsonValue &jsin, const cata_path &json_path )
 {
+    invalidate_indices();
     JsonArray ja = jsin.get_array();
     JsonObject jo = ja.next_object();
 
@@ -1738,6 +1741,8 @@ void creature_tracker::deserialize( const JsonArray &ja )
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    submap_of_monster.clear();
     for( JsonValue jv : ja ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
         shared_ptr_fast<monster> mptr = make_shared_fast<monster>();
@@ -1807,6 +1812,7 @@ void npc::import_and_clean( const JsonObject &data )
     last_updated = defaults.last_updated;
     lifespan_end = defaults.lifespan_end;
     effects->clear();
+    invalidate_flag_cache();
     consumption_history = defaults.consumption_history;
     last_sleep_check = defaults.last_sleep_check;
     queued_effect_on_conditions = defaults.queued_effect_on_conditions;
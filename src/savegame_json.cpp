@@ -1272,6 +1272,7 @@ void Character::load( const JsonObject &data )
     }
     data.read( "inactive_eocs", inactive_effect_on_condition_vector );
     update_enchantment_mutations();
+    invalidate_flag_cache();
 }
 
 /**
@@ -2961,13 +2962,9 @@ void item::io( Archive &archive )
     // Books without any chapters don't need to store a remaining-chapters
     // counter, it will always be 0 and it prevents proper stacking.
     if( get_chapters() == 0 ) {
-        for( auto it = item_vars.begin(); it != item_vars.end(); ) {
-            if( it->first.compare( 0, 19, "remaining-chapters-" ) == 0 ) {
-                item_vars.erase( it++ );
-            } else {
-                ++it;
-            }
-        }
+        item_vars.erase_if( []( const std::string & name ) {
+            return name.compare( 0, 19, "remaining-chapters-" ) == 0;
+        } );
     }
 
     static const std::set<std::string> removed_item_vars = {
@@ -2980,6 +2977,7 @@ void item::io( Archive &archive )
     for( const std::string &var : removed_item_vars ) {
         item_vars.erase( var );
     }
+    cached_base_measures.reset();
 
     current_phase = static_cast<phase_id>( cur_phase );
     // override phase if frozen, needed for legacy save
@@ -5055,6 +5053,7 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
                     } else if( ft != field_type_str_id::NULL_ID() &&
                                m->fld[i][j].add_field( ft.id(), intensity, time_duration::from_turns( age ) ) ) {
                         field_count++;
+                        m->fld_tiles.set( field_tile_index( { i, j } ) );
                     }
                 } else { // Handle removed int enum method
                     field_json.next_value(); // Skip intensity
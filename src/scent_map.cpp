@@ -175,14 +175,6 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
-
     // these are for caching flag lookups
     scent_array<bool> blocks_scent; // currently only ter_furn_flag::TFLAG_NO_SCENT blocks scent
     scent_array<bool> reduces_scent;
@@ -200,66 +192,66 @@ void scent_map::update( const tripoint &center, map &m )
     // The new scent flag searching function. Should be wayyy faster than the old one.
     m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
                       point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    // Both passes below work on whole columns (x fixed, y contiguous in memory) without branches,
+    // so that the compiler can vectorize the inner loops. Every cell is computed exactly like the
+    // old per-cell version did, including the order of the integer divisions.
+
     // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
+    // times. Each square contributes with a weight of 10, 2 if it is a REDUCE_SCENT square (only
+    // 20% of scent can diffuse on those), or 0 if it blocks scent.
+    // note: this needs an array that is one square larger on each side in the x direction
     // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
     // MAPSIZE_X, but if that changes, this may need tweaking.
+    scent_array<int> sum_3_scent_y;
+    scent_array<int> squares_used_y;
+    std::array<int, MAPSIZE_Y> weight;
+    std::array<int, MAPSIZE_Y> weighted_scent;
     for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        const std::array<bool, MAPSIZE_Y> &blocks = blocks_scent[x];
+        const std::array<bool, MAPSIZE_Y> &reduces = reduces_scent[x];
+        const std::array<int, MAPSIZE_Y> &scent = grscent[x];
+        for( int y = scentmap_miny - 1; y <= scentmap_maxy + 1; ++y ) {
+            weight[y] = blocks[y] ? 0 : reduces[y] ? 2 : 10;
+            weighted_scent[y] = weight[y] * scent[y];
+        }
+        std::array<int, MAPSIZE_Y> &sum_3 = sum_3_scent_y[x];
+        std::array<int, MAPSIZE_Y> &used = squares_used_y[x];
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum_3[y] = weighted_scent[y - 1] + weighted_scent[y] + weighted_scent[y + 1];
+            used[y] = weight[y - 1] + weight[y] + weight[y + 1];
         }
     }
 
     // Rest of the scent map
     for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        const std::array<bool, MAPSIZE_Y> &blocks = blocks_scent[x];
+        const std::array<bool, MAPSIZE_Y> &reduces = reduces_scent[x];
+        const std::array<int, MAPSIZE_Y> &used_w = squares_used_y[x - 1];
+        const std::array<int, MAPSIZE_Y> &used_c = squares_used_y[x];
+        const std::array<int, MAPSIZE_Y> &used_e = squares_used_y[x + 1];
+        const std::array<int, MAPSIZE_Y> &sum_w = sum_3_scent_y[x - 1];
+        const std::array<int, MAPSIZE_Y> &sum_c = sum_3_scent_y[x];
+        const std::array<int, MAPSIZE_Y> &sum_e = sum_3_scent_y[x + 1];
+        std::array<int, MAPSIZE_Y> &scent = grscent[x];
         for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            int &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring REDUCE_SCENT squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent via NO_SCENT (in json)
-                scent_here = 0;
-            }
+            const int scent_here = scent[y];
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = used_w[y] + used_c[y] + used_e[y];
+            //less air movement for REDUCE_SCENT square
+            const int this_diffusivity = reduces[y] ? diffusivity / 5 : diffusivity;
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring REDUCE_SCENT squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // we've already summed neighboring scent values in the y direction in the previous
+            // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+            // diffuses into our current square.
+            const int diffused = ( temp_scent + this_diffusivity * ( sum_w[y] + sum_c[y] + sum_e[y] ) ) /
+                                 ( 1000 * 10 );
+            // cells that block scent via NO_SCENT (in json) are cleared
+            scent[y] = blocks[y] ? 0 : diffused;
         }
     }
 }
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iterator>
+#include <vector>
 
 #include "cuboid_rectangle.h"
 #include "fragment_cloud.h" // IWYU pragma: keep
@@ -42,6 +43,87 @@ static bool operator==( const slope &lhs, const slope &rhs )
     return lhs.rise * rhs.run == rhs.rise * lhs.run;
 }
 
+void transparency_planes::build( const cata::mdarray<float, point_bub_ms> &transparency )
+{
+    partial.clear();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( size_t word = 0; word < words_per_row; ++word ) {
+            uint64_t open_air_bits = 0;
+            uint64_t solid_bits = 0;
+            const int first_y = static_cast<int>( word * 64 );
+            const int last_y = std::min( first_y + 64, MAPSIZE_Y );
+            for( int y = first_y; y < last_y; ++y ) {
+                const float value = transparency[x][y];
+                const uint64_t bit = uint64_t( 1 ) << ( y - first_y );
+                if( value == LIGHT_TRANSPARENCY_OPEN_AIR ) {
+                    open_air_bits |= bit;
+                } else if( value == LIGHT_TRANSPARENCY_SOLID ) {
+                    solid_bits |= bit;
+                } else {
+                    partial.emplace_back( x * MAPSIZE_Y + y, value );
+                }
+            }
+            open_air[x][word] = open_air_bits;
+            solid[x][word] = solid_bits;
+        }
+    }
+}
+
+void transparency_planes::unpack( cata::mdarray<float, point_bub_ms> &transparency ) const
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            transparency[x][y] = at( x, y );
+        }
+    }
+}
+
+void transparency_planes::set( const int x, const int y, const float value )
+{
+    const size_t word = static_cast<size_t>( y ) / 64;
+    const uint64_t bit = uint64_t( 1 ) << ( y % 64 );
+    const int index = x * MAPSIZE_Y + y;
+    open_air[x][word] &= ~bit;
+    solid[x][word] &= ~bit;
+    const auto iter = std::lower_bound( partial.begin(), partial.end(), index, partial_before );
+    const bool was_partial = iter != partial.end() && iter->first == index;
+    if( value == LIGHT_TRANSPARENCY_OPEN_AIR ) {
+        open_air[x][word] |= bit;
+    } else if( value == LIGHT_TRANSPARENCY_SOLID ) {
+        solid[x][word] |= bit;
+    } else if( was_partial ) {
+        iter->second = value;
+        return;
+    } else {
+        partial.emplace( iter, index, value );
+        return;
+    }
+    if( was_partial ) {
+        partial.erase( iter );
+    }
+}
+
+float transparency_planes::partial_at( const int index ) const
+{
+    const auto iter = std::lower_bound( partial.begin(), partial.end(), index, partial_before );
+    if( iter == partial.end() || iter->first != index ) {
+        // Not reachable for planes built from a cache, every tile is in one of the three
+        return LIGHT_TRANSPARENCY_SOLID;
+    }
+    return iter->second;
+}
+
+template<typename T>
+static T transparency_at( const cata::mdarray<T, point_bub_ms> &input, const int x, const int y )
+{
+    return input[x][y];
+}
+
+static float transparency_at( const transparency_planes &input, const int x, const int y )
+{
+    return input.at( x, y );
+}
+
 template<typename T>
 struct span {
     span( const slope &s_major, const slope &e_major,
@@ -156,12 +238,12 @@ static void split_span( cata::list<span<T>> &spans,
 }
 
 template<int xx_transform, int xy_transform, int yx_transform, int yy_transform, int z_transform, typename T,
-         T( *calc )( const T &, const T &, const int & ),
+         typename Input, T( *calc )( const T &, const T &, const int & ),
          bool( *is_transparent )( const T &, const T & ),
          T( *accumulate )( const T &, const T &, const int & )>
 void cast_horizontal_zlight_segment(
     const array_of_grids_of<T> &output_caches,
-    const array_of_grids_of<const T> &input_arrays,
+    const std::array<const Input *, OVERMAP_LAYERS> &input_arrays,
     const array_of_grids_of<const bool> &floor_caches,
     const tripoint_bub_ms &offset, const int offset_distance,
     const T numerator )
@@ -175,6 +257,10 @@ void cast_horizontal_zlight_segment(
     slope new_start_minor( 1, 1 );
 
     T last_intensity( 0.0 );
+    // Intensity only changes with the distance and the span, so neighbouring tiles share it
+    T calc_cumulative_value( 0.0 );
+    int calc_dist = -1;
+    T calc_intensity( 0.0 );
     tripoint delta;
     tripoint current;
 
@@ -271,7 +357,7 @@ void cast_horizontal_zlight_segment(
                         break;
                     }
 
-                    T new_transparency = ( *input_arrays[z_index] )[current.x][current.y];
+                    T new_transparency = transparency_at( *input_arrays[z_index], current.x, current.y );
 
                     // If we're looking at a tile with floor or roof from the floor/roof side,
                     // that tile is actually invisible to us.
@@ -296,7 +382,12 @@ void cast_horizontal_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    if( dist != calc_dist || !( this_span->cumulative_value == calc_cumulative_value ) ) {
+                        calc_dist = dist;
+                        calc_cumulative_value = this_span->cumulative_value;
+                        calc_intensity = calc( numerator, calc_cumulative_value, dist );
+                    }
+                    last_intensity = calc_intensity;
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x][current.y] =
@@ -351,13 +442,13 @@ void cast_horizontal_zlight_segment(
     }
 }
 
-template<int x_transform, int y_transform, int z_transform, typename T,
+template<int x_transform, int y_transform, int z_transform, typename T, typename Input,
          T( *calc )( const T &, const T &, const int & ),
          bool( *is_transparent )( const T &, const T & ),
          T( *accumulate )( const T &, const T &, const int & )>
 void cast_vertical_zlight_segment(
     const array_of_grids_of<T> &output_caches,
-    const array_of_grids_of<const T> &input_arrays,
+    const std::array<const Input *, OVERMAP_LAYERS> &input_arrays,
     const array_of_grids_of<const bool> &floor_caches,
     const tripoint_bub_ms &offset, const int offset_distance,
     const T numerator )
@@ -370,6 +461,10 @@ void cast_vertical_zlight_segment(
     slope new_start_minor( 1, 1 );
 
     T last_intensity( 0.0 );
+    // Intensity only changes with the distance and the span, so neighbouring tiles share it
+    T calc_cumulative_value( 0.0 );
+    int calc_dist = -1;
+    T calc_intensity( 0.0 );
     tripoint delta;
     tripoint current;
 
@@ -445,7 +540,7 @@ void cast_vertical_zlight_segment(
 
                     const int z_index = current.z + OVERMAP_DEPTH;
 
-                    T new_transparency = ( *input_arrays[z_index] )[current.x][current.y];
+                    T new_transparency = transparency_at( *input_arrays[z_index], current.x, current.y );
 
                     // If we're looking at a tile with floor or roof from the floor/roof side,
                     // that tile is actually invisible to us.
@@ -468,7 +563,12 @@ void cast_vertical_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    if( dist != calc_dist || !( this_span->cumulative_value == calc_cumulative_value ) ) {
+                        calc_dist = dist;
+                        calc_cumulative_value = this_span->cumulative_value;
+                        calc_intensity = calc( numerator, calc_cumulative_value, dist );
+                    }
+                    last_intensity = calc_intensity;
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x][current.y] =
@@ -523,12 +623,12 @@ void cast_vertical_zlight_segment(
     }
 }
 
-template<typename T, T( *calc )( const T &, const T &, const int & ),
+template<typename T, typename Input, T( *calc )( const T &, const T &, const int & ),
          bool( *is_transparent )( const T &, const T & ),
          T( *accumulate )( const T &, const T &, const int & )>
-void cast_zlight(
+static void cast_zlight_segments(
     const array_of_grids_of<T> &output_caches,
-    const array_of_grids_of<const T> &input_arrays,
+    const std::array<const Input *, OVERMAP_LAYERS> &input_arrays,
     const array_of_grids_of<const bool> &floor_caches,
     const tripoint_bub_ms &origin, const int offset_distance, const T numerator,
     vertical_direction dir )
@@ -538,60 +638,60 @@ void cast_zlight(
         // @..
         //  ..
         //   .
-        cast_horizontal_zlight_segment < 0, 1, 1, 0, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, 1, 1, 0, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // @
         // ..
         // ...
-        cast_horizontal_zlight_segment < 1, 0, 0, 1, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 1, 0, 0, 1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         //   .
         //  ..
         // @..
-        cast_horizontal_zlight_segment < 0, -1, 1, 0, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, -1, 1, 0, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ...
         // ..
         // @
-        cast_horizontal_zlight_segment < -1, 0, 0, 1, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < -1, 0, 0, 1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ..@
         // ..
         // .
-        cast_horizontal_zlight_segment < 0, 1, -1, 0, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, 1, -1, 0, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         //   @
         //  ..
         // ...
-        cast_horizontal_zlight_segment < 1, 0, 0, -1, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 1, 0, 0, -1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // .
         // ..
         // ..@
-        cast_horizontal_zlight_segment < 0, -1, -1, 0, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, -1, -1, 0, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ...
         //  ..
         //   @
-        cast_horizontal_zlight_segment < -1, 0, 0, -1, -1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < -1, 0, 0, -1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
 
         // Straight down
         // @.
         // ..
-        cast_vertical_zlight_segment < 1, 1, -1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < 1, 1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ..
         // @.
-        cast_vertical_zlight_segment < 1, -1, -1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < 1, -1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // .@
         // ..
-        cast_vertical_zlight_segment < -1, 1, -1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < -1, 1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ..
         // .@
-        cast_vertical_zlight_segment < -1, -1, -1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < -1, -1, -1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
     }
 
@@ -600,64 +700,90 @@ void cast_zlight(
         // @..
         //  ..
         //   .
-        cast_horizontal_zlight_segment < 0, 1, 1, 0, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, 1, 1, 0, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // @
         // ..
         // ...
-        cast_horizontal_zlight_segment < 1, 0, 0, 1, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 1, 0, 0, 1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ..@
         // ..
         // .
-        cast_horizontal_zlight_segment < 0, -1, 1, 0, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, -1, 1, 0, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         //   @
         //  ..
         // ...
-        cast_horizontal_zlight_segment < -1, 0, 0, 1, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < -1, 0, 0, 1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         //   .
         //  ..
         // @..
-        cast_horizontal_zlight_segment < 0, 1, -1, 0, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, 1, -1, 0, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ...
         // ..
         // @
-        cast_horizontal_zlight_segment < 1, 0, 0, -1, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 1, 0, 0, -1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // .
         // ..
         // ..@
-        cast_horizontal_zlight_segment < 0, -1, -1, 0, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < 0, -1, -1, 0, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ...
         //  ..
         //   @
-        cast_horizontal_zlight_segment < -1, 0, 0, -1, 1, T, calc, is_transparent, accumulate > (
+        cast_horizontal_zlight_segment < -1, 0, 0, -1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
 
         // Straight up
         // @.
         // ..
-        cast_vertical_zlight_segment < 1, 1, 1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < 1, 1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ..
         // @.
-        cast_vertical_zlight_segment < 1, -1, 1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < 1, -1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // .@
         // ..
-        cast_vertical_zlight_segment < -1, 1, 1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < -1, 1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
         // ..
         // .@
-        cast_vertical_zlight_segment < -1, -1, 1, T, calc, is_transparent, accumulate > (
+        cast_vertical_zlight_segment < -1, -1, 1, T, Input, calc, is_transparent, accumulate > (
             output_caches, input_arrays, floor_caches, origin, offset_distance, numerator );
     }
 }
 
+template<typename T, T( *calc )( const T &, const T &, const int & ),
+         bool( *is_transparent )( const T &, const T & ),
+         T( *accumulate )( const T &, const T &, const int & )>
+void cast_zlight(
+    const array_of_grids_of<T> &output_caches,
+    const array_of_grids_of<const T> &input_arrays,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, const int offset_distance, const T numerator,
+    vertical_direction dir )
+{
+    cast_zlight_segments<T, cata::mdarray<T, point_bub_ms>, calc, is_transparent, accumulate>(
+        output_caches, input_arrays, floor_caches, origin, offset_distance, numerator, dir );
+}
+
+void cast_zlight(
+    const array_of_grids_of<float> &output_caches,
+    const array_of_transparency_planes &input_planes,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, const int offset_distance, const float numerator,
+    vertical_direction dir )
+{
+    cast_zlight_segments<float, transparency_planes, sight_calc, sight_check,
+                         accumulate_transparency>(
+                             output_caches, input_planes, floor_caches, origin, offset_distance, numerator, dir );
+}
+
 // I can't figure out how to make implicit instantiation work when the parameters of
 // the template-supplied function pointers are involved, so I'm explicitly instantiating instead.
 template void cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
@@ -5,8 +5,12 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <utility>
+#include <vector>
 
 #include "coords_fwd.h"
 #include "game_constants.h"
@@ -132,6 +136,56 @@ using array_of_grids_of =
     std::array<cata::mdarray<T, point_bub_ms>*, OVERMAP_LAYERS>
     >;
 
+/**
+ * Transparency of one z-level packed into bit planes, for casting vision.
+ *
+ * Nearly every tile is either open air or solid, so those are kept as one bit each. The few
+ * remaining tiles, like the ones covered by smoke, keep their exact value in a sparse overlay.
+ * Casting over the planes gives the same results as casting over the cache they were built
+ * from, while reading a small fraction of the memory.
+ */
+class transparency_planes
+{
+    public:
+        void build( const cata::mdarray<float, point_bub_ms> &transparency );
+        /** Writes the transparency of every tile back into a float cache. */
+        void unpack( cata::mdarray<float, point_bub_ms> &transparency ) const;
+        void set( int x, int y, float value );
+
+        float at( int x, int y ) const {
+            const size_t word = static_cast<size_t>( y ) / 64;
+            const uint64_t bit = uint64_t( 1 ) << ( y % 64 );
+            if( open_air[x][word] & bit ) {
+                return LIGHT_TRANSPARENCY_OPEN_AIR;
+            }
+            if( solid[x][word] & bit ) {
+                return LIGHT_TRANSPARENCY_SOLID;
+            }
+            return partial_at( x * MAPSIZE_Y + y );
+        }
+
+        /** Number of tiles that are neither open air nor solid. */
+        size_t partial_tiles() const {
+            return partial.size();
+        }
+
+    private:
+        static constexpr size_t words_per_row = ( MAPSIZE_Y + 63 ) / 64;
+        using plane = std::array<std::array<uint64_t, words_per_row>, MAPSIZE_X>;
+
+        float partial_at( int index ) const;
+        static bool partial_before( const std::pair<int, float> &tile, int index ) {
+            return tile.first < index;
+        }
+
+        plane open_air = {};
+        plane solid = {};
+        // Sorted by the index of the tile
+        std::vector<std::pair<int, float>> partial;
+};
+
+using array_of_transparency_planes = std::array<const transparency_planes *, OVERMAP_LAYERS>;
+
 // TODO: Generalize the floor check, allow semi-transparent floors
 template< typename T, T( *calc )( const T &, const T &, const int & ),
           bool( *check )( const T &, const T & ),
@@ -143,4 +197,13 @@ void cast_zlight(
     const tripoint_bub_ms &origin, int offset_distance, T numerator,
     vertical_direction dir = vertical_direction::BOTH );
 
+// Casts vision like cast_zlight<float, sight_calc, sight_check, accumulate_transparency>,
+// reading the transparency from bit planes
+void cast_zlight(
+    const array_of_grids_of<float> &output_caches,
+    const array_of_transparency_planes &input_planes,
+    const array_of_grids_of<const bool> &floor_caches,
+    const tripoint_bub_ms &origin, int offset_distance, float numerator,
+    vertical_direction dir = vertical_direction::BOTH );
+
 #endif // CATA_SRC_SHADOWCASTING_H
@@ -0,0 +1,97 @@
+#include "sight_cache.h"
+
+#include <algorithm>
+
+#include "coordinates.h"
+#include "game_constants.h"
+
+// Bubble coordinates are packed into 10 bits each, z-levels into 5
+static bool packable( const tripoint_bub_ms &p )
+{
+    return p.x() >= 0 && p.x() < 1024 && p.y() >= 0 && p.y() < 1024 &&
+           p.z() >= -OVERMAP_DEPTH && p.z() <= OVERMAP_HEIGHT;
+}
+
+static uint64_t pack( const tripoint_bub_ms &p )
+{
+    return static_cast<uint64_t>( p.x() ) << 15 | static_cast<uint64_t>( p.y() ) << 5 |
+           static_cast<uint64_t>( p.z() + OVERMAP_DEPTH );
+}
+
+static uint64_t sight_key( const tripoint_bub_ms &from, const tripoint_bub_ms &to,
+                           bool with_fields )
+{
+    // Canonicalize the order of the points so the cache is symmetric.
+    const tripoint_bub_ms &min = from < to ? from : to;
+    const tripoint_bub_ms &max = from < to ? to : from;
+    return pack( min ) << 26 | pack( max ) << 1 | ( with_fields ? 1 : 0 );
+}
+
+static size_t home_slot( uint64_t key, size_t bits )
+{
+    return static_cast<size_t>( ( key * 0x9E3779B97F4A7C15ULL ) >> ( 64 - bits ) );
+}
+
+void sight_cache::start_turn()
+{
+    if( turn != calendar::turn ) {
+        turn = calendar::turn;
+        invalidate();
+    }
+}
+
+int sight_cache::get( const tripoint_bub_ms &from, const tripoint_bub_ms &to, bool with_fields )
+{
+    start_turn();
+    if( table && packable( from ) && packable( to ) ) {
+        const uint64_t key = sight_key( from, to, with_fields );
+        const size_t home = home_slot( key, table_bits );
+        for( size_t i = 0; i < max_probes; ++i ) {
+            const entry &e = table[( home + i ) & ( table_size - 1 )];
+            if( e.generation != generation ) {
+                // Slots are taken in order, nothing was stored past a free one
+                break;
+            }
+            if( e.key == key ) {
+                ++counters.hits;
+                return e.visible ? 1 : 0;
+            }
+        }
+    }
+    ++counters.misses;
+    return -1;
+}
+
+void sight_cache::insert( const tripoint_bub_ms &from, const tripoint_bub_ms &to,
+                          bool with_fields, bool visible )
+{
+    start_turn();
+    if( !packable( from ) || !packable( to ) ) {
+        return;
+    }
+    if( !table ) {
+        table = std::make_unique<entry[]>( table_size );
+    }
+    const uint64_t key = sight_key( from, to, with_fields );
+    const size_t home = home_slot( key, table_bits );
+    for( size_t i = 0; i < max_probes; ++i ) {
+        entry &e = table[( home + i ) & ( table_size - 1 )];
+        if( e.generation != generation || e.key == key ) {
+            e = { key, generation, visible };
+            return;
+        }
+    }
+    table[home] = { key, generation, visible };
+}
+
+void sight_cache::invalidate()
+{
+    ++counters.invalidations;
+    if( ++generation == 0 ) {
+        // Wrapped around, old entries could look current again
+        if( table ) {
+            std::fill( table.get(), table.get() + table_size, entry{ 0, 0, false } );
+        }
+        generation = 1;
+    }
+}
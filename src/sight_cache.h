@@ -0,0 +1,65 @@
+#pragma once
+#ifndef CATA_SRC_SIGHT_CACHE_H
+#define CATA_SRC_SIGHT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "calendar.h"
+#include "coords_fwd.h"
+
+struct sight_cache_stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    // Times all results were dropped, for a new turn or because the map changed
+    uint64_t invalidations = 0;
+};
+
+/**
+ * Remembers the results of line of sight checks between two points of the reality bubble.
+ *
+ * Lines of sight are treated as symmetric, a check from A to B answers the one from B to A
+ * as well. The results only depend on the transparency and floor caches, so they are dropped
+ * whenever those change and at the start of every turn.
+ *
+ * The results are kept in a fixed size open addressing table that is only allocated once
+ * something is stored. When all slots a check may go to are taken, the first of them is
+ * overwritten.
+ */
+class sight_cache
+{
+    public:
+        /** Returns 1 or 0 for a remembered result, or -1 if there is none. */
+        int get( const tripoint_bub_ms &from, const tripoint_bub_ms &to, bool with_fields );
+        void insert( const tripoint_bub_ms &from, const tripoint_bub_ms &to, bool with_fields,
+                     bool visible );
+        /** Drops all results. */
+        void invalidate();
+
+        const sight_cache_stats &stats() const {
+            return counters;
+        }
+
+    private:
+        struct entry {
+            uint64_t key;
+            // Entries of older generations are free slots
+            uint32_t generation;
+            bool visible;
+        };
+
+        static constexpr size_t table_bits = 17;
+        static constexpr size_t table_size = size_t( 1 ) << table_bits;
+        // How many slots from its home slot a key may be stored in
+        static constexpr size_t max_probes = 8;
+
+        void start_turn();
+
+        std::unique_ptr<entry[]> table;
+        uint32_t generation = 1;
+        time_point turn = calendar::before_time_starts;
+        sight_cache_stats counters;
+};
+
+#endif // CATA_SRC_SIGHT_CACHE_H
@@ -0,0 +1,66 @@
+#include "slab_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace cata
+{
+
+static size_t aligned_block_size( size_t size )
+{
+    const size_t alignment = alignof( std::max_align_t );
+    return ( std::max( size, sizeof( void * ) ) + alignment - 1 ) / alignment * alignment;
+}
+
+slab_pool::slab_pool( size_t block_size, size_t blocks_per_slab )
+    : block_size( aligned_block_size( block_size ) ), blocks_per_slab( std::max<size_t>( blocks_per_slab,
+            1 ) )
+{
+}
+
+slab_pool::~slab_pool() = default;
+
+void *slab_pool::allocate()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    if( free_list == nullptr ) {
+        // Not value initialized, the blocks are constructed into anyway
+        slabs.emplace_back( new char[block_size * blocks_per_slab] );
+        char *slab = slabs.back().get();
+        // Chained back to front, so that the blocks are handed out in address order
+        for( size_t i = blocks_per_slab; i-- > 0; ) {
+            free_list = new( slab + i * block_size ) free_block{ free_list };
+        }
+        free += blocks_per_slab;
+    }
+    free_block *block = free_list;
+    free_list = block->next;
+    --free;
+    ++live;
+    return block;
+}
+
+void slab_pool::deallocate( void *block ) noexcept
+{
+    if( block == nullptr ) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock( mutex );
+    free_list = new( block ) free_block{ free_list };
+    ++free;
+    --live;
+}
+
+slab_stats slab_pool::stats() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    slab_stats result;
+    result.block_size = block_size;
+    result.slabs = slabs.size();
+    result.live = live;
+    result.free = free;
+    return result;
+}
+
+} // namespace cata
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef CATA_SRC_SLAB_POOL_H
+#define CATA_SRC_SLAB_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cata
+{
+
+struct slab_stats {
+    size_t block_size = 0;
+    size_t slabs = 0;
+    // Blocks handed out and not given back yet
+    size_t live = 0;
+    // Blocks given back and waiting to be reused
+    size_t free = 0;
+};
+
+/**
+ * Hands out blocks of one size, carved from large slabs.
+ *
+ * Meant for objects that are created and destroyed in large numbers, so that they do not
+ * churn the general heap. Freed blocks are kept for reuse and the slabs are only released
+ * when the pool is destroyed.
+ */
+class slab_pool
+{
+    public:
+        slab_pool( size_t block_size, size_t blocks_per_slab );
+        slab_pool( const slab_pool & ) = delete;
+        slab_pool &operator=( const slab_pool & ) = delete;
+        ~slab_pool();
+
+        void *allocate();
+        void deallocate( void *block ) noexcept;
+
+        slab_stats stats() const;
+
+    private:
+        struct free_block {
+            free_block *next;
+        };
+
+        const size_t block_size;
+        const size_t blocks_per_slab;
+        std::vector<std::unique_ptr<char[]>> slabs;
+        free_block *free_list = nullptr;
+        size_t live = 0;
+        size_t free = 0;
+        mutable std::mutex mutex;
+};
+
+} // namespace cata
+
+#endif // CATA_SRC_SLAB_POOL_H
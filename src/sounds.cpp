@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
 #include <type_traits>
 #include <unordered_map>
 
@@ -33,6 +34,7 @@
 #include "overmapbuffer.h"
 #include "player_activity.h"
 #include "point.h"
+#include "profiling.h"
 #include "rng.h"
 #include "safemode_ui.h"
 #include "string_formatter.h"
@@ -475,10 +477,100 @@ static int get_signal_for_hordes( const centroid &centr )
     return 0;
 }
 
+namespace
+{
+// The monsters in the reality bubble, binned by the submap they are on, so that a sound only
+// has to look at the monsters on submaps it can be heard on rather than at every monster.
+class sound_listener_grid
+{
+    public:
+        sound_listener_grid() {
+            for( monster &critter : g->all_monsters() ) {
+                listeners.push_back( &critter );
+            }
+            // Counting sort by bucket, which keeps the listeners in each bucket in their original order.
+            std::vector<int> bucket_of( listeners.size() );
+            bucket_start.assign( num_buckets + 1, 0 );
+            for( size_t i = 0; i < listeners.size(); ++i ) {
+                bucket_of[i] = bucket_index( listeners[i]->pos() );
+                ++bucket_start[bucket_of[i] + 1];
+            }
+            std::partial_sum( bucket_start.begin(), bucket_start.end(), bucket_start.begin() );
+            std::vector<int> next_slot( bucket_start.begin(), bucket_start.end() - 1 );
+            sorted.resize( listeners.size() );
+            for( size_t i = 0; i < listeners.size(); ++i ) {
+                sorted[next_slot[bucket_of[i]]++] = static_cast<int>( i );
+            }
+        }
+
+        // Calls fn with every monster whose sound_distance to source might be below range,
+        // in the same order as g->all_monsters().
+        template<typename Fn>
+        void for_each_in_range( const tripoint &source, int range, const Fn &fn ) {
+            if( range <= 0 || listeners.empty() ) {
+                return;
+            }
+            // The horizontal part of sound_distance is never less than the larger of dx and dy.
+            const point min_sm = clamp_sm( source.xy() - point( range - 1, range - 1 ) );
+            const point max_sm = clamp_sm( source.xy() + point( range - 1, range - 1 ) );
+            candidates.clear();
+            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+                if( sound_distance( source, tripoint( source.xy(), z ) ) >= range ) {
+                    continue;
+                }
+                for( int x = min_sm.x; x <= max_sm.x; ++x ) {
+                    for( int y = min_sm.y; y <= max_sm.y; ++y ) {
+                        const int bucket = bucket_index( z, point( x, y ) );
+                        candidates.insert( candidates.end(), sorted.begin() + bucket_start[bucket],
+                                           sorted.begin() + bucket_start[bucket + 1] );
+                    }
+                }
+            }
+            std::sort( candidates.begin(), candidates.end() );
+            for( const int i : candidates ) {
+                fn( *listeners[i] );
+            }
+        }
+
+    private:
+        static constexpr int num_buckets = OVERMAP_LAYERS * MAPSIZE * MAPSIZE;
+
+        static point clamp_sm( const point &p ) {
+            return point( std::clamp( p.x / SEEX, 0, MAPSIZE - 1 ), std::clamp( p.y / SEEY, 0, MAPSIZE - 1 ) );
+        }
+        static int bucket_index( int z, const point &sm ) {
+            return ( ( std::clamp( z, -OVERMAP_DEPTH, OVERMAP_HEIGHT ) + OVERMAP_DEPTH ) * MAPSIZE + sm.x ) *
+                   MAPSIZE + sm.y;
+        }
+        static int bucket_index( const tripoint &p ) {
+            return bucket_index( p.z, clamp_sm( p.xy() ) );
+        }
+
+        std::vector<monster *> listeners;
+        // Indices into listeners, grouped by bucket
+        std::vector<int> sorted;
+        // Bucket b is sorted[bucket_start[b]] up to sorted[bucket_start[b + 1]]
+        std::vector<int> bucket_start;
+        std::vector<int> candidates;
+};
+} // namespace
+
 void sounds::process_sounds()
 {
+    profiling::scoped_zone profile( profiling::zone::process_sounds );
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
+    if( sound_clusters.empty() ) {
+        recent_sounds.clear();
+        return;
+    }
+    map &here = get_map();
     const int weather_vol = get_weather().weather_id->sound_attn;
+    sound_listener_grid listeners;
+    std::vector<tripoint_bub_ms> sound_trap_locations;
+    for( const trap *trapType : trap::get_sound_triggered_traps() ) {
+        const std::vector<tripoint_bub_ms> &locations = here.trap_locations( trapType->id );
+        sound_trap_locations.insert( sound_trap_locations.end(), locations.begin(), locations.end() );
+    }
     for( const centroid &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -490,31 +582,29 @@ void sounds::process_sounds()
         int sig_power = get_signal_for_hordes( this_centroid );
         if( sig_power > 0 ) {
 
-            const point abs_ms = get_map().getabs( source.xy() );
+            const point abs_ms = here.getabs( source.xy() );
             // TODO: fix point types
             const point_abs_sm abs_sm( ms_to_sm_copy( abs_ms ) );
             const tripoint_abs_sm target( abs_sm, source.z );
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        listeners.for_each_in_range( source, vol * 2, [&]( monster & critter ) {
             // TODO: Generalize this to Creature::hear_sound
             const int dist = sound_distance( source, critter.pos() );
             if( vol * 2 > dist ) {
                 // Exclude monsters that certainly won't hear the sound
                 critter.hear_sound( source, vol, dist, this_centroid.provocative );
             }
-        }
+        } );
         // Trigger sound-triggered traps and ensure they are still valid
-        for( const trap *trapType : trap::get_sound_triggered_traps() ) {
-            for( const tripoint_bub_ms &tp : get_map().trap_locations( trapType->id ) ) {
-                const int dist = sound_distance( source, tp.raw() );
-                const trap &tr = get_map().tr_at( tp );
-                // Exclude traps that certainly won't hear the sound
-                if( vol * 2 > dist ) {
-                    if( tr.triggered_by_sound( vol, dist ) ) {
-                        tr.trigger( tp.raw() );
-                    }
+        for( const tripoint_bub_ms &tp : sound_trap_locations ) {
+            const int dist = sound_distance( source, tp.raw() );
+            // Exclude traps that certainly won't hear the sound
+            if( vol * 2 > dist ) {
+                const trap &tr = here.tr_at( tp );
+                if( tr.triggered_by_sound( vol, dist ) ) {
+                    tr.trigger( tp.raw() );
                 }
             }
         }
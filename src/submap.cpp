@@ -4,10 +4,12 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <new>
 #include <utility>
 
 #include "basecamp.h"
 #include "mapdata.h"
+#include "slab_pool.h"
 #include "tileray.h"
 #include "trap.h"
 #include "units.h"
@@ -19,6 +21,38 @@ static const furn_str_id furn_f_console( "f_console" );
 
 static const trap_str_id tr_ledge( "tr_ledge" );
 
+// Never destroyed: submaps are owned by globals that may be destroyed after any static here.
+static cata::slab_pool &tile_pool()
+{
+    static cata::slab_pool *pool = new cata::slab_pool( sizeof( maptile_soa ), 16 );
+    return *pool;
+}
+
+static cata::slab_pool &submap_pool()
+{
+    static cata::slab_pool *pool = new cata::slab_pool( sizeof( submap ), 128 );
+    return *pool;
+}
+
+void *maptile_soa::operator new( size_t size )
+{
+    return size == sizeof( maptile_soa ) ? tile_pool().allocate() : ::operator new( size );
+}
+
+void maptile_soa::operator delete( void *p, size_t size ) noexcept
+{
+    if( size == sizeof( maptile_soa ) ) {
+        tile_pool().deallocate( p );
+    } else {
+        ::operator delete( p );
+    }
+}
+
+cata::slab_stats maptile_soa::allocation_stats()
+{
+    return tile_pool().stats();
+}
+
 void maptile_soa::swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 )
 {
     std::swap( ter[p1.x()][p1.y()], ter[p2.x()][p2.y()] );
@@ -26,6 +60,11 @@ void maptile_soa::swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 )
     std::swap( lum[p1.x()][p1.y()], lum[p2.x()][p2.y()] );
     std::swap( itm[p1.x()][p1.y()], itm[p2.x()][p2.y()] );
     std::swap( fld[p1.x()][p1.y()], fld[p2.x()][p2.y()] );
+    const size_t fld_tile1 = submap::field_tile_index( p1 );
+    const size_t fld_tile2 = submap::field_tile_index( p2 );
+    const bool fld_tile1_set = fld_tiles[fld_tile1];
+    fld_tiles[fld_tile1] = fld_tiles[fld_tile2];
+    fld_tiles[fld_tile2] = fld_tile1_set;
     std::swap( trp[p1.x()][p1.y()], trp[p2.x()][p2.y()] );
     std::swap( rad[p1.x()][p1.y()], rad[p2.x()][p2.y()] );
 }
@@ -35,11 +74,31 @@ submap::~submap() = default;
 
 submap &submap::operator=( submap && ) noexcept = default;
 
+void *submap::operator new( size_t size )
+{
+    return size == sizeof( submap ) ? submap_pool().allocate() : ::operator new( size );
+}
+
+void submap::operator delete( void *p, size_t size ) noexcept
+{
+    if( size == sizeof( submap ) ) {
+        submap_pool().deallocate( p );
+    } else {
+        ::operator delete( p );
+    }
+}
+
+cata::slab_stats submap::allocation_stats()
+{
+    return submap_pool().stats();
+}
+
 void submap::clear_fields( const point_sm_ms &p )
 {
     field &f = get_field( p );
     field_count -= f.field_count();
     f.clear();
+    clear_field_tile( p );
 }
 
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
@@ -85,6 +144,7 @@ const std::string &submap::get_graffiti( const point_sm_ms &p ) const
 
 void submap::set_graffiti( const point_sm_ms &p, const std::string &new_graffiti )
 {
+    mark_modified();
     ensure_nonuniform();
     // Find signage at p if available
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
@@ -97,6 +157,7 @@ void submap::set_graffiti( const point_sm_ms &p, const std::string &new_graffiti
 
 void submap::delete_graffiti( const point_sm_ms &p )
 {
+    mark_modified();
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         ensure_nonuniform();
@@ -125,6 +186,7 @@ std::string submap::get_signage( const point_sm_ms &p ) const
 }
 void submap::set_signage( const point_sm_ms &p, const std::string &s )
 {
+    mark_modified();
     ensure_nonuniform();
     // Find signage at p if available
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
@@ -136,6 +198,7 @@ void submap::set_signage( const point_sm_ms &p, const std::string &s )
 }
 void submap::delete_signage( const point_sm_ms &p )
 {
+    mark_modified();
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         ensure_nonuniform();
@@ -162,6 +225,7 @@ const computer *submap::get_computer( const point_sm_ms &p ) const
 
 computer *submap::get_computer( const point_sm_ms &p )
 {
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         return &it->second;
@@ -171,6 +235,7 @@ computer *submap::get_computer( const point_sm_ms &p )
 
 void submap::set_computer( const point_sm_ms &p, const computer &c )
 {
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         it->second = c;
@@ -181,6 +246,7 @@ void submap::set_computer( const point_sm_ms &p, const computer &c )
 
 void submap::delete_computer( const point_sm_ms &p )
 {
+    mark_modified();
     computers.erase( p );
 }
 
@@ -202,6 +268,7 @@ bool submap::is_open_air( const point_sm_ms &p ) const
 
 void submap::rotate( int turns )
 {
+    mark_modified();
     if( is_uniform() ) {
         return;
     }
@@ -279,6 +346,7 @@ void submap::rotate( int turns )
 
 void submap::mirror( bool horizontally )
 {
+    mark_modified();
     if( is_uniform() ) {
         return;
     }
@@ -323,6 +391,7 @@ void submap::mirror( bool horizontally )
 
 void submap::revert_submap( submap &sr )
 {
+    mark_modified();
     reverted = true;
     if( sr.is_uniform() ) {
         m.reset();
@@ -348,6 +417,31 @@ void submap::revert_submap( submap &sr )
     }
 }
 
+submap_item_stats &submap_item_stats::operator+=( const submap_item_stats &rhs )
+{
+    submaps += rhs.submaps;
+    items += rhs.items;
+    slots += rhs.slots;
+    bytes += rhs.bytes;
+    return *this;
+}
+
+submap_item_stats submap::item_stats() const
+{
+    submap_item_stats stats;
+    stats.submaps = 1;
+    if( is_uniform() ) {
+        return stats;
+    }
+    stats.bytes = elements * sizeof( cata::colony<item> );
+    std::for_each_n( &m->itm[0][0], elements, [&stats]( const cata::colony<item> &items ) {
+        stats.items += items.size();
+        stats.slots += items.capacity();
+    } );
+    stats.bytes += stats.slots * ( sizeof( item ) + sizeof( cata::colony<item>::skipfield_type ) );
+    return stats;
+}
+
 submap submap::get_revert_submap() const
 {
     submap ret;
@@ -385,6 +479,7 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
 
 void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
 {
+    mark_modified();
     this->field_count = 0;
 
     for( int x = 0; x < SEEX; x++ ) {
@@ -422,6 +517,9 @@ void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
                  it != this->m->fld[x][y].end(); it++ ) {
                 this->field_count++;
             }
+            if( this->m->fld[x][y].field_count() > 0 ) {
+                this->m->fld_tiles.set( field_tile_index( { x, y } ) );
+            }
 
             if( copy_from->m->trp[x][y] != tr_null && ( copy_from_is_overlay ||
                     this->m->trp[x][y] == tr_null ) ) {
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <algorithm>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -27,6 +29,7 @@
 #include "mapgen.h"
 #include "mdarray.h"
 #include "point.h"
+#include "slab_pool.h"
 #include "trap.h"
 #include "type_id.h"
 #include "vehicle.h"
@@ -64,8 +67,33 @@ struct maptile_soa {
     cata::mdarray<field, point_sm_ms>              fld; // Field on each square
     cata::mdarray<trap_id, point_sm_ms>            trp; // Trap on each square
     cata::mdarray<int, point_sm_ms>                rad; // Irradiation of each square
+    // Squares that may have a field, indexed by x * SEEY + y. Set whenever a square's field
+    // is handed out for writing, cleared when field processing finds the square empty.
+    std::bitset<SEEX *SEEY>                        fld_tiles;
+
+    // First group size of the item colony of each square. Most squares with items hold one or
+    // a few, the colony default would make room for eight on the first insert.
+    static constexpr cata::colony<item>::skipfield_type item_group_size = 3;
 
     void swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 );
+
+    // These are big, all of the same size, and come and go with every map shift, so they
+    // are kept in a pool of their own instead of the general heap.
+    static void *operator new( size_t size );
+    static void operator delete( void *p, size_t size ) noexcept;
+    static cata::slab_stats allocation_stats();
+};
+
+/** Memory held by the items on submaps, see @ref submap::item_stats */
+struct submap_item_stats {
+    size_t submaps = 0;
+    size_t items = 0;
+    // Item slots allocated, used or not
+    size_t slots = 0;
+    // Slots and the per square colonies
+    size_t bytes = 0;
+
+    submap_item_stats &operator+=( const submap_item_stats &rhs );
 };
 
 class submap
@@ -77,6 +105,11 @@ class submap
 
         submap &operator=( submap && ) noexcept;
 
+        // Pooled like maptile_soa
+        static void *operator new( size_t size );
+        static void operator delete( void *p, size_t size ) noexcept;
+        static cata::slab_stats allocation_stats();
+
         void ensure_nonuniform() {
             if( is_uniform() ) {
                 m = std::make_unique<maptile_soa>();
@@ -85,9 +118,14 @@ class submap
                 std::uninitialized_fill_n( &m->lum[0][0], elements, 0 );
                 std::uninitialized_fill_n( &m->trp[0][0], elements, tr_null );
                 std::uninitialized_fill_n( &m->rad[0][0], elements, 0 );
+                std::for_each_n( &m->itm[0][0], elements, []( cata::colony<item> &items ) {
+                    items.change_minimum_group_size( maptile_soa::item_group_size );
+                } );
             }
         }
 
+        submap_item_stats item_stats() const;
+
         void revert_submap( submap &sr );
 
         submap get_revert_submap() const;
@@ -101,11 +139,13 @@ class submap
 
         void set_trap( const point_sm_ms &p, trap_id trap ) {
             ensure_nonuniform();
+            mark_modified();
             m->trp[p.x()][p.y()] = trap;
         }
 
         void set_all_traps( const trap_id &trap ) {
             ensure_nonuniform();
+            mark_modified();
             std::uninitialized_fill_n( &m->trp[0][0], elements, trap );
         }
 
@@ -118,11 +158,13 @@ class submap
 
         void set_furn( const point_sm_ms &p, furn_id furn ) {
             ensure_nonuniform();
+            mark_modified();
             m->frn[p.x()][p.y()] = furn;
         }
 
         void set_all_furn( const furn_id &furn ) {
             ensure_nonuniform();
+            mark_modified();
             std::uninitialized_fill_n( &m->frn[0][0], elements, furn );
         }
         int get_map_damage( const point_sm_ms &p ) const {
@@ -134,6 +176,7 @@ class submap
         }
 
         void set_map_damage( const point_sm_ms &p, int dmg ) {
+            mark_modified();
             ephemeral_data[p] = { dmg };
         }
 
@@ -146,10 +189,12 @@ class submap
 
         void set_ter( const point_sm_ms &p, ter_id terr ) {
             ensure_nonuniform();
+            mark_modified();
             m->ter[p.x()][p.y()] = terr;
         }
 
         void set_all_ter( const ter_id &terr, bool uniform_ok = false ) {
+            mark_modified();
             if( !uniform_ok ) {
                 ensure_nonuniform();
             }
@@ -169,6 +214,7 @@ class submap
 
         void set_radiation( const point_sm_ms &p, const int radiation ) {
             ensure_nonuniform();
+            mark_modified();
             m->rad[p.x()][p.y()] = radiation;
         }
 
@@ -194,7 +240,9 @@ class submap
         void update_lum_rem( const point_sm_ms &p, const item &i );
 
         // TODO: Replace this as it essentially makes itm public
+        // Anything may be done with the items through this, so it counts as a modification.
         cata::colony<item> &get_items( const point_sm_ms &p ) {
+            mark_modified();
             if( is_uniform() ) {
                 cata::colony<item> static noitems;
                 return noitems;
@@ -212,10 +260,12 @@ class submap
 
         // TODO: Replace this as it essentially makes fld public
         field &get_field( const point_sm_ms &p ) {
+            mark_modified();
             if( is_uniform() ) {
                 field static nofield;
                 return nofield;
             }
+            m->fld_tiles.set( field_tile_index( p ) );
             return m->fld[p.x()][p.y()];
         }
 
@@ -229,6 +279,23 @@ class submap
 
         void clear_fields( const point_sm_ms &p );
 
+        static constexpr size_t field_tile_index( const point_sm_ms &p ) {
+            return static_cast<size_t>( p.x() * SEEY + p.y() );
+        }
+        static constexpr point_sm_ms field_tile_point( const size_t index ) {
+            return point_sm_ms( static_cast<int>( index / SEEY ), static_cast<int>( index % SEEY ) );
+        }
+        /** Squares that may have a field, see maptile_soa::fld_tiles */
+        const std::bitset<SEEX *SEEY> &field_tiles() const {
+            static const std::bitset<SEEX *SEEY> no_field_tiles;
+            return is_uniform() ? no_field_tiles : m->fld_tiles;
+        }
+        void clear_field_tile( const point_sm_ms &p ) {
+            if( !is_uniform() ) {
+                m->fld_tiles.reset( field_tile_index( p ) );
+            }
+        }
+
         struct cosmetic_t {
             point_sm_ms pos;
             std::string type;
@@ -236,6 +303,7 @@ class submap
         };
 
         void insert_cosmetic( const point_sm_ms &p, const std::string &type, const std::string &str ) {
+            mark_modified();
             cosmetic_t ins;
 
             ins.pos = p;
@@ -250,6 +318,7 @@ class submap
         }
 
         void set_temperature_mod( units::temperature_delta new_temperature_mod ) {
+            mark_modified();
             temperature_mod = units::to_fahrenheit_delta( new_temperature_mod );
         }
 
@@ -285,6 +354,33 @@ class submap
         void store( JsonOut &jsout ) const;
         void load( const JsonValue &jv, const std::string &member_name, int version );
 
+        /**
+         * Changes whenever something that @ref store writes may have changed, so that mapbuffer
+         * can skip writing quads that are the same as on disk. Changing the public members below
+         * directly does not count; the map functions that do so call @ref mark_modified.
+         */
+        unsigned int get_generation() const {
+            return generation;
+        }
+        void mark_modified() {
+            ++generation;
+        }
+        /**
+         * Whether this submap may differ from what was last written to or read from disk.
+         * Vehicles and camps change in too many ways to track, so they are always written.
+         */
+        bool modified_since_saved() const {
+            return generation != saved_generation || !vehicles.empty() || camp;
+        }
+        /** Called by mapbuffer once the submap is the same as on disk. */
+        void set_saved() {
+            saved_generation = generation;
+            saved_last_touched = last_touched;
+        }
+        time_point get_saved_last_touched() const {
+            return saved_last_touched;
+        }
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform() const {
@@ -327,6 +423,9 @@ class submap
         std::unique_ptr<maptile_soa> m;
         ter_id uniform_ter = t_null;
         int temperature_mod = 0; // delta in F
+        unsigned int generation = 1; // NOLINT(cata-serialize)
+        unsigned int saved_generation = 0; // NOLINT(cata-serialize)
+        time_point saved_last_touched = calendar::turn_zero; // NOLINT(cata-serialize)
 
         static constexpr size_t elements = SEEX * SEEY;
 };
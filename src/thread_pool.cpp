@@ -0,0 +1,149 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "options.h"
+
+namespace cata
+{
+
+thread_pool::thread_pool( int num_workers )
+{
+    workers.reserve( std::max( num_workers, 0 ) );
+    for( int i = 0; i < num_workers; ++i ) {
+        workers.emplace_back( &thread_pool::worker_loop, this );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    task_available.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+void thread_pool::worker_loop()
+{
+    while( true ) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            task_available.wait( lock, [this] {
+                return stopping || !tasks.empty();
+            } );
+            // Drain the queue before stopping, so nothing submitted is lost.
+            if( tasks.empty() ) {
+                return;
+            }
+            task = std::move( tasks.front() );
+            tasks.pop_front();
+            ++running;
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            --running;
+        }
+        task_finished.notify_all();
+    }
+}
+
+void thread_pool::submit( std::function<void()> task )
+{
+    if( workers.empty() ) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        tasks.emplace_back( std::move( task ) );
+    }
+    task_available.notify_one();
+}
+
+void thread_pool::wait_idle()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    task_finished.wait( lock, [this] {
+        return tasks.empty() && running == 0;
+    } );
+}
+
+void thread_pool::parallel_for( size_t count, const std::function<void( size_t )> &fn )
+{
+    const size_t helpers = std::min( workers.size(), count > 0 ? count - 1 : 0 );
+    if( helpers == 0 ) {
+        for( size_t i = 0; i < count; ++i ) {
+            fn( i );
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_index( 0 );
+    std::mutex join_mutex;
+    std::condition_variable join_cv;
+    size_t helpers_done = 0;
+    std::exception_ptr first_error;
+
+    const auto run_chunk = [&]() {
+        try {
+            for( size_t i = next_index++; i < count; i = next_index++ ) {
+                fn( i );
+            }
+        } catch( ... ) {
+            std::lock_guard<std::mutex> lock( join_mutex );
+            if( !first_error ) {
+                first_error = std::current_exception();
+            }
+            // Stop handing out further indices.
+            next_index = count;
+        }
+    };
+
+    for( size_t h = 0; h < helpers; ++h ) {
+        submit( [&]() {
+            run_chunk();
+            std::lock_guard<std::mutex> lock( join_mutex );
+            ++helpers_done;
+            // Notify under the lock: join_cv lives on the caller's stack.
+            join_cv.notify_one();
+        } );
+    }
+    run_chunk();
+
+    std::unique_lock<std::mutex> lock( join_mutex );
+    join_cv.wait( lock, [&] {
+        return helpers_done == helpers;
+    } );
+    if( first_error ) {
+        std::rethrow_exception( first_error );
+    }
+}
+
+} // namespace cata
+
+static std::unique_ptr<cata::thread_pool> shared_pool;
+
+cata::thread_pool &get_thread_pool()
+{
+    const int wanted = std::max( get_option<int>( "WORKER_THREADS" ), 0 );
+    if( !shared_pool || shared_pool->num_workers() != wanted ) {
+        shared_pool.reset();
+        shared_pool = std::make_unique<cata::thread_pool>( wanted );
+    }
+    return *shared_pool;
+}
+
+bool worker_threads_enabled()
+{
+    return get_thread_pool().num_workers() > 0;
+}
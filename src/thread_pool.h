@@ -0,0 +1,76 @@
+#pragma once
+#ifndef CATA_SRC_THREAD_POOL_H
+#define CATA_SRC_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+namespace cata
+{
+
+/**
+ * A small fixed-size pool of worker threads.
+ *
+ * Tasks submitted to the pool must not touch the UI (debugmsg, popups, ...) or
+ * any state that is not owned by the task itself, as they run concurrently
+ * with each other and, for @ref parallel_for, with the calling thread.
+ */
+class thread_pool
+{
+    public:
+        explicit thread_pool( int num_workers );
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+        ~thread_pool();
+
+        /** Number of worker threads, not counting the calling thread. */
+        int num_workers() const {
+            return static_cast<int>( workers.size() );
+        }
+
+        /**
+         * Calls fn( i ) for every i in [0, count) and returns once all calls have finished.
+         * The calling thread takes part in the work, so this is safe to use with zero workers.
+         * The first exception thrown by any call is rethrown here after the join.
+         */
+        void parallel_for( size_t count, const std::function<void( size_t )> &fn );
+
+        /** Queues a task to be run on a worker, or runs it immediately if there are none. */
+        void submit( std::function<void()> task );
+
+        /** Blocks until every task queued so far has finished. */
+        void wait_idle();
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable task_available;
+        std::condition_variable task_finished;
+        size_t running = 0;
+        bool stopping = false;
+};
+
+} // namespace cata
+
+/**
+ * The shared worker pool, sized by the "WORKER_THREADS" option.
+ * The pool is recreated if the option changed since the last call.
+ */
+cata::thread_pool &get_thread_pool();
+
+/** Whether the shared worker pool has any workers, i.e. parallel work is enabled at all. */
+bool worker_threads_enabled();
+
+#endif // CATA_SRC_THREAD_POOL_H
@@ -0,0 +1,136 @@
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "bionics.h"
+#include "calendar.h"
+#include "cata_catch.h"
+#include "character.h"
+#include "flag.h"
+#include "map_helpers.h"
+#include "npc.h"
+#include "player_helpers.h"
+#include "type_id.h"
+#include "units.h"
+
+static const bionic_id bio_blindfold( "bio_blindfold" );
+static const bionic_id bio_power_storage( "bio_power_storage" );
+static const bionic_id test_bio_blade_heatsink( "test_bio_blade_heatsink" );
+
+static const efftype_id effect_downed( "downed" );
+
+static const json_character_flag json_flag_BLIND( "BLIND" );
+static const json_character_flag json_flag_DISABLE_FLIGHT( "DISABLE_FLIGHT" );
+static const json_character_flag json_flag_HEATSINK( "HEATSINK" );
+static const json_character_flag json_flag_WEB_RAPPEL( "WEB_RAPPEL" );
+
+static const trait_id trait_WEB_RAPPEL( "WEB_RAPPEL" );
+
+// Every flag the cached count_flag disagrees with the uncached one on
+static std::vector<std::string> mismatched_flags( const Character &guy )
+{
+    std::vector<std::string> mismatched;
+    for( const json_flag &flag : json_flag::get_all() ) {
+        const int uncached = guy.count_flag_uncached( flag.id );
+        if( guy.count_flag( flag.id ) != uncached || guy.has_flag( flag.id ) != ( uncached > 0 ) ) {
+            mismatched.push_back( flag.id.str() );
+        }
+    }
+    return mismatched;
+}
+
+TEST_CASE( "flag_cache_matches_uncached_flags", "[character][flag]" )
+{
+    clear_avatar();
+    avatar &guy = get_avatar();
+    CHECK( mismatched_flags( guy ).empty() );
+
+    SECTION( "traits" ) {
+        guy.set_mutation( trait_WEB_RAPPEL );
+        CHECK( !guy.has_flag( json_flag_WEB_RAPPEL ) );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        guy.activate_mutation( trait_WEB_RAPPEL );
+        REQUIRE( guy.has_active_mutation( trait_WEB_RAPPEL ) );
+        CHECK( guy.has_flag( json_flag_WEB_RAPPEL ) );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        guy.deactivate_mutation( trait_WEB_RAPPEL );
+        CHECK( !guy.has_flag( json_flag_WEB_RAPPEL ) );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        guy.unset_mutation( trait_WEB_RAPPEL );
+        CHECK( mismatched_flags( guy ).empty() );
+    }
+
+    SECTION( "bionics" ) {
+        guy.add_bionic( bio_power_storage );
+        guy.add_bionic( bio_blindfold );
+        guy.set_power_level( guy.get_max_power_level() );
+        CHECK( !guy.has_flag( json_flag_BLIND ) );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        std::optional<bionic *> bio = guy.find_bionic_by_type( bio_blindfold );
+        REQUIRE( bio );
+        guy.activate_bionic( **bio );
+        REQUIRE( guy.has_active_bionic( bio_blindfold ) );
+        CHECK( guy.has_flag( json_flag_BLIND ) );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        guy.deactivate_bionic( **bio );
+        CHECK( !guy.has_flag( json_flag_BLIND ) );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        guy.clear_bionics();
+        CHECK( mismatched_flags( guy ).empty() );
+    }
+
+    SECTION( "effects" ) {
+        guy.add_effect( effect_downed, 1_minutes );
+        CHECK( guy.count_flag( json_flag_DISABLE_FLIGHT ) == 1 );
+        CHECK( mismatched_flags( guy ).empty() );
+
+        guy.remove_effect( effect_downed );
+        CHECK( !guy.has_flag( json_flag_DISABLE_FLIGHT ) );
+        CHECK( mismatched_flags( guy ).empty() );
+    }
+}
+
+TEST_CASE( "npc_weapon_cbm_flags_follow_its_state", "[character][flag][npc]" )
+{
+    clear_map();
+    standard_npc guy( "Test NPC" );
+    guy.add_bionic( bio_power_storage );
+    guy.add_bionic( test_bio_blade_heatsink );
+    guy.set_power_level( guy.get_max_power_level() );
+    REQUIRE( !guy.has_flag( json_flag_HEATSINK ) );
+
+    guy.check_or_use_weapon_cbm( test_bio_blade_heatsink );
+    REQUIRE( guy.has_active_bionic( test_bio_blade_heatsink ) );
+    CHECK( guy.has_flag( json_flag_HEATSINK ) );
+    CHECK( mismatched_flags( guy ).empty() );
+
+    std::optional<bionic *> bio = guy.find_bionic_by_type( test_bio_blade_heatsink );
+    REQUIRE( bio );
+    guy.deactivate_bionic( **bio );
+    REQUIRE( !guy.has_active_bionic( test_bio_blade_heatsink ) );
+    CHECK( !guy.has_flag( json_flag_HEATSINK ) );
+    CHECK( mismatched_flags( guy ).empty() );
+}
+
+TEST_CASE( "flag_cache_benchmark", "[.][character][flag][benchmark]" )
+{
+    clear_avatar();
+    avatar &guy = get_avatar();
+    guy.set_mutation( trait_WEB_RAPPEL );
+    guy.add_bionic( bio_blindfold );
+    guy.add_effect( effect_downed, 1_minutes );
+
+    BENCHMARK( "count_flag" ) {
+        return guy.count_flag( json_flag_BLIND );
+    };
+    BENCHMARK( "count_flag_uncached" ) {
+        return guy.count_flag_uncached( json_flag_BLIND );
+    };
+}
@@ -2397,3 +2397,51 @@ TEST_CASE( "pseudo_tools_in_crafting_inventory", "[crafting][tools]" )
         clear_map();
     }
 }
+
+TEST_CASE( "crafting_inventory_follows_item_changes", "[crafting][inventory]" )
+{
+    clear_avatar();
+    clear_map();
+    avatar &player = get_avatar();
+    map &here = get_map();
+    const tripoint_bub_ms next_to_player = player.pos_bub() + tripoint_east;
+
+    REQUIRE( player.crafting_inventory().count_item( itype_hammer ) == 0 );
+
+    // Neither moves nor the turn change below, which used to be all that rebuilt the inventory
+    here.add_item( next_to_player, item( itype_hammer ) );
+    CHECK( player.crafting_inventory().count_item( itype_hammer ) == 1 );
+    CHECK( player.crafting_inventory().has_quality( qual_HAMMER ) );
+
+    player.i_add( item( itype_hammer ) );
+    CHECK( player.crafting_inventory().count_item( itype_hammer ) == 2 );
+
+    here.i_clear( next_to_player );
+    CHECK( player.crafting_inventory().count_item( itype_hammer ) == 1 );
+
+    player.use_amount( itype_hammer, 1 );
+    CHECK( player.crafting_inventory().count_item( itype_hammer ) == 0 );
+    CHECK_FALSE( player.crafting_inventory().has_quality( qual_HAMMER ) );
+
+    SECTION( "unchanged surroundings reuse the same inventory within the turn" ) {
+        here.add_item( next_to_player, item( itype_sheet_cotton ) );
+        const inventory &first = player.crafting_inventory();
+        const item *sheet = &first.find_item( first.position_by_type( itype_sheet_cotton ) );
+        const inventory &second = player.crafting_inventory();
+        CHECK( &second.find_item( second.position_by_type( itype_sheet_cotton ) ) == sheet );
+    }
+    SECTION( "charges changed in place show up once moves are spent" ) {
+        item thread( itype_thread );
+        thread.charges = 50;
+        item &placed = here.add_item( next_to_player, thread );
+        REQUIRE( player.crafting_inventory().charges_of( itype_thread ) == 50 );
+        // Nothing tells the map about this, as with rot or active item processing
+        placed.charges = 10;
+        player.mod_moves( -100 );
+        CHECK( player.crafting_inventory().charges_of( itype_thread ) == 10 );
+        placed.charges = 5;
+        calendar::turn += 1_turns;
+        CHECK( player.crafting_inventory().charges_of( itype_thread ) == 5 );
+    }
+    clear_map();
+}
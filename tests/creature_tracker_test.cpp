@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <vector>
+
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "rng.h"
+
+static bool is_near( const std::vector<monster *> &found, const monster &critter )
+{
+    return std::find( found.begin(), found.end(), &critter ) != found.end();
+}
+
+TEST_CASE( "monsters_near_follows_moving_monsters", "[creature_tracker][monster]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    creature_tracker &creatures = get_creature_tracker();
+    const tripoint center( 60, 60, 0 );
+    monster &close = spawn_test_monster( "mon_zombie", center + tripoint( 3, -2, 0 ) );
+    monster &edge = spawn_test_monster( "mon_zombie", center + tripoint( -10, 10, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", center + tripoint( 30, 0, 0 ) );
+    monster &below = spawn_test_monster( "mon_zombie", center + tripoint( 0, 1, -1 ) );
+
+    std::vector<monster *> found = creatures.monsters_near( here.getglobal( center ), 10, 0 );
+    CHECK( found.size() == 2 );
+    CHECK( is_near( found, close ) );
+    CHECK( is_near( found, edge ) );
+
+    // Crossing into another submap has to be picked up
+    far.setpos( center + tripoint( 11, 0, 0 ) );
+    edge.setpos( center + tripoint( -9, 10, 0 ) );
+    found = creatures.monsters_near( here.getglobal( center ), 11, 1 );
+    CHECK( found.size() == 4 );
+    CHECK( is_near( found, far ) );
+    CHECK( is_near( found, below ) );
+
+    creatures.swap_positions( close, far );
+    found = creatures.monsters_near( here.getglobal( center ), 5, 0 );
+    CHECK( found.size() == 1 );
+    CHECK( is_near( found, far ) );
+
+    g->remove_zombie( far );
+    close.die( nullptr );
+    found = creatures.monsters_near( here.getglobal( center ), 20, 1 );
+    CHECK( found.size() == 2 );
+    CHECK_FALSE( is_near( found, far ) );
+    CHECK_FALSE( is_near( found, close ) );
+}
+
+// The pets of a large camp going through a horde: every friendly monster looks for hostile
+// monsters to attack each turn.
+TEST_CASE( "friendly_monster_planning_benchmark", "[.][creature_tracker][monster][benchmark]" )
+{
+    clear_map_and_put_player_underground();
+    std::vector<monster *> pets;
+    for( int i = 0; i < 50; ++i ) {
+        monster &pet = spawn_test_monster( "mon_dog", tripoint( 55 + i % 10, 55 + i / 10, 0 ) );
+        pet.friendly = -1;
+        pets.push_back( &pet );
+    }
+    int hostiles = 0;
+    while( hostiles < 300 ) {
+        const tripoint where( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( get_creature_tracker().creature_at( where ) == nullptr ) {
+            spawn_test_monster( "mon_zombie", where );
+            ++hostiles;
+        }
+    }
+
+    BENCHMARK( "plan 50 friendly vs 300 hostile" ) {
+        for( monster *pet : pets ) {
+            pet->plan();
+        }
+        return pets.size();
+    };
+}
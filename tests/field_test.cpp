@@ -1,4 +1,5 @@
 #include <iosfwd>
+#include <tuple>
 #include <vector>
 
 #include "avatar.h"
@@ -11,16 +12,19 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "map_iterator.h"
+#include "mapbuffer.h"
 #include "mapdata.h"
 #include "options_helpers.h"
 #include "player_helpers.h"
 #include "point.h"
+#include "submap.h"
 #include "type_id.h"
 #include "weather.h"
 
 static const efftype_id effect_test_rash( "test_rash" );
 
 static const field_type_str_id field_fd_acid( "fd_acid" );
+static const field_type_str_id field_fd_smoke( "fd_smoke" );
 static const field_type_str_id field_fd_test( "fd_test" );
 
 static const ter_str_id ter_t_open_air( "t_open_air" );
@@ -479,6 +483,57 @@ TEST_CASE( "field_API_test", "[field]" )
     fields_test_cleanup();
 }
 
+// Tiles with fields that field processing would skip, it only visits the submap's field tiles
+static int unlisted_field_tiles( const int zlevel )
+{
+    map &m = get_map();
+    int unlisted = 0;
+    for( const tripoint_bub_ms &p : m.bub_points_on_zlevel( zlevel ) ) {
+        tripoint_abs_sm sm_pos;
+        point_sm_ms l;
+        std::tie( sm_pos, l ) = project_remain<coords::sm>( m.getglobal( p ) );
+        const submap *sm = MAPBUFFER.lookup_submap( sm_pos );
+        if( sm->get_field( l ).field_count() > 0 && !sm->field_tiles()[submap::field_tile_index( l )] ) {
+            unlisted++;
+        }
+    }
+    return unlisted;
+}
+
+TEST_CASE( "fields_are_processed_from_the_submap_field_tiles", "[field]" )
+{
+    fields_test_setup();
+    map &m = get_map();
+    const tripoint_bub_ms p{ 33, 33, 0 };
+    tripoint_abs_sm sm_pos;
+    point_sm_ms l;
+    std::tie( sm_pos, l ) = project_remain<coords::sm>( m.getglobal( p ) );
+    const submap *sm = MAPBUFFER.lookup_submap( sm_pos );
+    REQUIRE( sm != nullptr );
+
+    m.add_field( p, field_fd_acid, 1 );
+    m.process_fields();
+    CHECK( sm->field_tiles().count() == 1 );
+    CHECK( sm->field_tiles()[submap::field_tile_index( l )] );
+
+    m.add_field( p, field_fd_smoke, 3 );
+    for( int i = 0; i < 20; ++i ) {
+        calendar::turn += 1_turns;
+        m.process_fields();
+        CHECK( unlisted_field_tiles( 0 ) == 0 );
+    }
+
+    for( const tripoint_bub_ms &pt : m.bub_points_on_zlevel( 0 ) ) {
+        m.clear_fields( pt.raw() );
+    }
+    m.add_field( p, field_fd_acid, 1 );
+    m.remove_field( p, field_fd_acid );
+    m.process_fields();
+    CHECK( sm->field_tiles().none() );
+
+    fields_test_cleanup();
+}
+
 TEST_CASE( "player_double_effect_field_test", "[field][player]" )
 {
     fields_test_setup();
@@ -5,6 +5,8 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "avatar.h"
@@ -15,6 +17,8 @@
 #include "game.h"
 #include "item_category.h"
 #include "item_factory.h"
+#include "json.h"
+#include "json_loader.h"
 #include "itype.h"
 #include "math_defines.h"
 #include "monstergenerator.h"
@@ -41,8 +45,12 @@ static const item_category_id item_category_tools( "tools" );
 
 static const itype_id itype_test_backpack( "test_backpack" );
 static const itype_id itype_test_duffelbag( "test_duffelbag" );
+static const itype_id itype_test_jug_plastic( "test_jug_plastic" );
 static const itype_id itype_test_mp3( "test_mp3" );
+static const itype_id itype_test_pipe( "test_pipe" );
+static const itype_id itype_test_rock( "test_rock" );
 static const itype_id itype_test_smart_phone( "test_smart_phone" );
+static const itype_id itype_test_socks( "test_socks" );
 static const itype_id itype_test_waterproof_bag( "test_waterproof_bag" );
 
 static const json_character_flag json_flag_DEAF( "DEAF" );
@@ -327,6 +335,62 @@ TEST_CASE( "item_variables_round-trip_accurately", "[item]" )
     CHECK( i.get_var( "C", tripoint() ) == tripoint( 2, 3, 4 ) );
 }
 
+TEST_CASE( "item_variables_read_back_as_the_strings_they_were_saved_as", "[item]" )
+{
+    item i( "water" );
+    i.set_var( "int", 17 );
+    i.set_var( "negative", -3 );
+    i.set_var( "double", 0.125 );
+    i.set_var( "point", tripoint( 2, -3, 4 ) );
+    i.set_var( "text", "some text" );
+    i.set_var( "padded", "017" );
+
+    CHECK( i.get_var( "int" ) == "17" );
+    CHECK( i.get_var( "negative" ) == "-3" );
+    CHECK( i.get_var( "double" ) == "0.125000" );
+    CHECK( i.get_var( "point" ) == "2,-3,4" );
+    CHECK( i.get_var( "padded" ) == "017" );
+    // Numbers set as strings read back as numbers and the other way around
+    i.set_var( "string_int", "42" );
+    CHECK( i.get_var( "string_int", 0 ) == 42 );
+    CHECK( i.get_var( "int", 0.0 ) == 17.0 );
+    CHECK( i.get_var( "missing", 5 ) == 5 );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    i.serialize( jsout );
+    item loaded;
+    loaded.deserialize( json_loader::from_string( os.str() ).get_object() );
+    for( const char *name : {
+             "int", "negative", "double", "point", "text", "padded", "string_int"
+         } ) {
+        CAPTURE( name );
+        CHECK( loaded.get_var( name ) == i.get_var( name ) );
+    }
+    CHECK( loaded.get_var( "point", tripoint() ) == tripoint( 2, -3, 4 ) );
+    CHECK( loaded.get_var( "double", 0.0 ) == 0.125 );
+}
+
+TEST_CASE( "item_variables_stack_by_value", "[item]" )
+{
+    item lhs( itype_test_rock );
+    item rhs( itype_test_rock );
+    REQUIRE( lhs.stacks_with( rhs ) );
+
+    lhs.set_var( "A", 1 );
+    CHECK( !lhs.stacks_with( rhs ) );
+    rhs.set_var( "A", "1" );
+    CHECK( lhs.stacks_with( rhs ) );
+    rhs.set_var( "B", 0.5 );
+    lhs.set_var( "B", "0.500000" );
+    CHECK( lhs.stacks_with( rhs ) );
+    rhs.set_var( "A", 2 );
+    CHECK( !lhs.stacks_with( rhs ) );
+    rhs.erase_var( "A" );
+    lhs.erase_var( "A" );
+    CHECK( lhs.stacks_with( rhs ) );
+}
+
 TEST_CASE( "water_affect_items_while_swimming_check", "[item][water][swimming]" )
 {
     avatar &guy = get_avatar();
@@ -1046,3 +1110,70 @@ TEST_CASE( "item_rotten_contents", "[item]" )
     //   butter
     CHECK( wrapper.get_category_of_contents().id == item_category_food );
 }
+
+TEST_CASE( "item_weight_and_volume_follow_variables_and_flags", "[item]" )
+{
+    item rock( itype_test_rock );
+    const units::mass weight = rock.weight();
+    const units::volume volume = rock.volume();
+
+    rock.set_var( "weight", to_milligram( weight * 2 ) );
+    CHECK( rock.weight() == weight * 2 );
+    rock.set_flag( flag_REDUCED_WEIGHT );
+    CHECK( rock.weight() == weight * 2 * 0.75 );
+    rock.unset_flag( flag_REDUCED_WEIGHT );
+    rock.erase_var( "weight" );
+    CHECK( rock.weight() == weight );
+
+    rock.set_var( "volume", 3 );
+    CHECK( rock.volume() == 3 * units::legacy_volume_factor );
+    rock.clear_vars();
+    CHECK( rock.volume() == volume );
+
+    rock.set_flag( flag_NO_DROP );
+    CHECK( rock.weight() == 0_gram );
+}
+
+TEST_CASE( "loaded_survivor_weight_benchmark", "[.][item][benchmark]" )
+{
+    clear_avatar();
+    avatar &guy = get_avatar();
+    guy.wear_item( item( itype_test_backpack ), false );
+    guy.wear_item( item( itype_test_duffelbag ), false );
+    const std::vector<itype_id> loot = { itype_test_rock, itype_test_socks, itype_test_pipe,
+                                         itype_test_jug_plastic
+                                       };
+    for( int i = 0; i < 400; ++i ) {
+        const item it( loot[i % loot.size()] );
+        if( guy.can_stash( it ) ) {
+            guy.i_add( it );
+        }
+    }
+
+    BENCHMARK( "weight carried" ) {
+        guy.invalidate_weight_carried_cache();
+        return guy.weight_carried();
+    };
+    BENCHMARK( "volume carried" ) {
+        return guy.volume_carried();
+    };
+}
+
+TEST_CASE( "item_variables_benchmark", "[.][item][benchmark]" )
+{
+    item it( itype_test_rock );
+    it.set_var( "counter", 3 );
+    it.set_var( "ratio", 0.5 );
+    it.set_var( "name", "a rock" );
+    it.set_var( "pos", tripoint( 1, 2, 3 ) );
+
+    BENCHMARK( "copy item with variables" ) {
+        return item( it );
+    };
+    BENCHMARK( "get_var" ) {
+        return it.get_var( "counter", 0 ) + it.get_var( "ratio", 0.0 );
+    };
+    BENCHMARK( "get_var missing" ) {
+        return it.get_var( "missing", 0 );
+    };
+}
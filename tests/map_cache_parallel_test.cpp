@@ -0,0 +1,120 @@
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "cata_catch.h"
+#include "field_type.h"
+#include "game_constants.h"
+#include "level_cache.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "shadowcasting.h"
+#include "type_id.h"
+
+static const field_type_str_id field_fd_smoke( "fd_smoke" );
+
+static const furn_str_id furn_f_table( "f_table" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_grass( "t_grass" );
+static const ter_str_id ter_t_open_air( "t_open_air" );
+static const ter_str_id ter_t_wall( "t_wall" );
+static const ter_str_id ter_t_window_frame( "t_window_frame" );
+
+static constexpr int test_minz = -2;
+static constexpr int test_maxz = 2;
+
+// Scatter walls, holes in the floor, furniture and smoke over several z-levels
+static void build_random_levels()
+{
+    map &here = get_map();
+    const std::array<ter_id, 5> terrains = { {
+            ter_t_floor.id(), ter_t_grass.id(), ter_t_open_air.id(), ter_t_wall.id(),
+            ter_t_window_frame.id()
+        }
+    };
+    for( int z = test_minz; z <= test_maxz; ++z ) {
+        for( int i = 0; i < 2000; ++i ) {
+            const tripoint_bub_ms p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), z );
+            here.ter_set( p, random_entry( terrains ) );
+            if( one_in( 10 ) ) {
+                here.furn_set( p, furn_f_table );
+            }
+            if( one_in( 20 ) ) {
+                here.add_field( p, field_fd_smoke, rng( 1, 3 ) );
+            }
+        }
+    }
+}
+
+static void dirty_all_caches()
+{
+    map &here = get_map();
+    for( int z = test_minz; z <= test_maxz; ++z ) {
+        here.set_transparency_cache_dirty( z );
+        here.set_outside_cache_dirty( z );
+        here.set_floor_cache_dirty( z );
+        here.set_seen_cache_dirty( z );
+    }
+}
+
+template<typename T>
+static bool same_bits( const T &lhs, const T &rhs )
+{
+    return std::memcmp( &lhs, &rhs, sizeof( T ) ) == 0;
+}
+
+static bool same_planes( const transparency_planes &lhs, const transparency_planes &rhs )
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( !same_bits( lhs.at( x, y ), rhs.at( x, y ) ) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static std::vector<std::unique_ptr<level_cache>> build_with_threads( const std::string &threads )
+{
+    override_option opt( "WORKER_THREADS", threads );
+    map &here = get_map();
+    dirty_all_caches();
+    here.build_map_cache( 0 );
+    std::vector<std::unique_ptr<level_cache>> result;
+    for( int z = test_minz; z <= test_maxz; ++z ) {
+        result.emplace_back( std::make_unique<level_cache>( here.get_cache_ref( z ) ) );
+    }
+    return result;
+}
+
+TEST_CASE( "parallel_map_cache_matches_serial", "[map][lightmap]" )
+{
+    clear_map( test_minz, test_maxz );
+    build_random_levels();
+
+    const std::vector<std::unique_ptr<level_cache>> serial = build_with_threads( "0" );
+    const std::vector<std::unique_ptr<level_cache>> parallel = build_with_threads( "3" );
+
+    REQUIRE( serial.size() == parallel.size() );
+    for( size_t i = 0; i < serial.size(); ++i ) {
+        const level_cache &s = *serial[i];
+        const level_cache &p = *parallel[i];
+        CAPTURE( test_minz + static_cast<int>( i ) );
+        CHECK( same_bits( s.outside_cache, p.outside_cache ) );
+        CHECK( same_bits( s.floor_cache, p.floor_cache ) );
+        CHECK( s.no_floor_gaps == p.no_floor_gaps );
+        CHECK( same_bits( s.transparency_cache, p.transparency_cache ) );
+        CHECK( s.transparent_cache_wo_fields == p.transparent_cache_wo_fields );
+        CHECK( same_planes( s.vision_transparency_planes, p.vision_transparency_planes ) );
+        CHECK( same_bits( s.seen_cache, p.seen_cache ) );
+        CHECK( same_bits( s.lm, p.lm ) );
+    }
+
+    clear_map( test_minz, test_maxz );
+}
@@ -101,6 +101,7 @@ void clear_fields( const int zlevel )
             if( sm ) {
                 sm->field_count = 0;
                 sm->get_field( offset ).clear();
+                sm->clear_field_tile( offset );
             }
         }
     }
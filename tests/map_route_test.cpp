@@ -0,0 +1,202 @@
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mtype.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "rng.h"
+#include "type_id.h"
+
+static const mtype_id mon_zombie( "mon_zombie" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
+// Lines of wall across the whole bubble, each with a few gaps, so that long routes have to
+// weave through them.
+static void build_maze_map()
+{
+    map &here = get_map();
+    clear_map();
+    for( const tripoint_bub_ms &p : here.bub_points_on_zlevel( 0 ) ) {
+        here.ter_set( p, ter_t_floor );
+    }
+    for( int x = SEEX; x < MAPSIZE_X - SEEX; x += 2 * SEEX ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( y % ( 3 * SEEY ) > 2 ) {
+                here.ter_set( tripoint_bub_ms( x, y, 0 ), ter_t_wall );
+            }
+        }
+    }
+}
+
+static void check_route( const map &here, const std::vector<tripoint> &route,
+                         const tripoint &from, const tripoint &to )
+{
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        CAPTURE( prev, p );
+        CHECK( square_dist( prev, p ) == 1 );
+        CHECK( here.passable( p ) );
+        prev = p;
+    }
+}
+
+static const pathfinding_settings long_route_settings( 0, 1000, 1000, 0, true, false, true, true,
+        false, true );
+
+// What the route costs the pathfinder on flat floor
+static int route_cost( const tripoint &from, const std::vector<tripoint> &route )
+{
+    int cost = 0;
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        cost += 2 + ( prev.x != p.x && prev.y != p.y ? 1 : 0 );
+        prev = p;
+    }
+    return cost;
+}
+
+// Cost of the cheapest route over the whole z-level, with the costs of route_cost
+static int cheapest_cost( const map &here, const tripoint &from, const tripoint &to,
+                          const std::function<bool( const tripoint & )> &avoid )
+{
+    std::vector<int> best( MAPSIZE_X * MAPSIZE_Y, INT_MAX );
+    using entry = std::pair<int, tripoint>;
+    const auto cmp = []( const entry & lhs, const entry & rhs ) {
+        return lhs.first > rhs.first;
+    };
+    std::priority_queue<entry, std::vector<entry>, decltype( cmp )> open( cmp );
+    best[from.x * MAPSIZE_Y + from.y] = 0;
+    open.emplace( 0, from );
+    while( !open.empty() ) {
+        const entry cur = open.top();
+        open.pop();
+        if( cur.second == to ) {
+            return cur.first;
+        }
+        if( cur.first > best[cur.second.x * MAPSIZE_Y + cur.second.y] ) {
+            continue;
+        }
+        for( const tripoint &p : here.points_in_radius( cur.second, 1 ) ) {
+            if( p == cur.second || !here.passable( p ) || ( p != to && avoid( p ) ) ) {
+                continue;
+            }
+            const int cost = cur.first + 2 + ( p.x != cur.second.x && p.y != cur.second.y ? 1 : 0 );
+            int &p_best = best[p.x * MAPSIZE_Y + p.y];
+            if( cost < p_best ) {
+                p_best = cost;
+                open.emplace( cost, p );
+            }
+        }
+    }
+    return INT_MAX;
+}
+
+TEST_CASE( "long_routes_are_continuous", "[map][pathfinding]" )
+{
+    build_maze_map();
+    map &here = get_map();
+
+    const tripoint from( 2, 2, 0 );
+    const tripoint to( MAPSIZE_X - 3, MAPSIZE_Y - 3, 0 );
+    const std::vector<tripoint> route = here.route( from, to, long_route_settings );
+    check_route( here, route, from, to );
+
+    SECTION( "closing a gap reroutes around it" ) {
+        for( int y = 0; y < 3; ++y ) {
+            here.ter_set( tripoint_bub_ms( SEEX, y, 0 ), ter_t_wall );
+        }
+        const std::vector<tripoint> rerouted = here.route( from, to, long_route_settings );
+        check_route( here, rerouted, from, to );
+    }
+
+    SECTION( "walled off destination has no route" ) {
+        for( const tripoint &p : closest_points_first( to, 1 ) ) {
+            if( p != to ) {
+                here.ter_set( tripoint_bub_ms( p ), ter_t_wall );
+            }
+        }
+        CHECK( here.route( from, to, long_route_settings ).empty() );
+    }
+}
+
+TEST_CASE( "long_routes_are_as_cheap_as_the_full_search", "[map][pathfinding]" )
+{
+    build_maze_map();
+    map &here = get_map();
+    const auto avoid_nothing = []( const tripoint & ) {
+        return false;
+    };
+    // The middle of each gap in the walls, where the submap crossings are
+    const auto avoid_gap_middles = []( const tripoint & p ) {
+        return p.x % ( 2 * SEEX ) == SEEX && p.y % ( 3 * SEEY ) == 1;
+    };
+
+    const std::vector<std::pair<tripoint, tripoint>> routes = {
+        { tripoint( 2, 2, 0 ), tripoint( MAPSIZE_X - 3, MAPSIZE_Y - 3, 0 ) },
+        { tripoint( 2, MAPSIZE_Y - 3, 0 ), tripoint( MAPSIZE_X - 3, 2, 0 ) },
+        { tripoint( MAPSIZE_X - 3, 5, 0 ), tripoint( 4, MAPSIZE_Y - 10, 0 ) },
+    };
+    for( const std::pair<tripoint, tripoint> &r : routes ) {
+        CAPTURE( r.first, r.second );
+        const std::vector<tripoint> route = here.route( r.first, r.second, long_route_settings );
+        check_route( here, route, r.first, r.second );
+        CHECK( route_cost( r.first, route ) == cheapest_cost( here, r.first, r.second, avoid_nothing ) );
+
+        const std::vector<tripoint> avoiding = here.route( r.first, r.second, long_route_settings,
+                                               avoid_gap_middles );
+        check_route( here, avoiding, r.first, r.second );
+        for( const tripoint &p : avoiding ) {
+            CAPTURE( p );
+            CHECK( !avoid_gap_middles( p ) );
+        }
+        CHECK( route_cost( r.first, avoiding ) ==
+               cheapest_cost( here, r.first, r.second, avoid_gap_middles ) );
+    }
+}
+
+TEST_CASE( "map_route_benchmark", "[.][pathfinding][benchmark]" )
+{
+    build_maze_map();
+    map &here = get_map();
+
+    std::vector<tripoint> starts;
+    while( starts.size() < 300 ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( here.passable( p ) ) {
+            starts.push_back( p );
+        }
+    }
+    const tripoint target( MAPSIZE_X / 2, MAPSIZE_Y / 2, 0 );
+    const pathfinding_settings &monster_settings = mon_zombie->path_settings;
+
+    BENCHMARK( "300 monster routes" ) {
+        size_t total = 0;
+        for( const tripoint &p : starts ) {
+            total += here.route( p, target, monster_settings ).size();
+        }
+        return total;
+    };
+
+    BENCHMARK( "300 routes across the bubble" ) {
+        size_t total = 0;
+        for( const tripoint &p : starts ) {
+            total += here.route( p, tripoint( MAPSIZE_X - 1 - p.x, MAPSIZE_Y - 1 - p.y, 0 ),
+                                 long_route_settings ).size();
+        }
+        return total;
+    };
+}
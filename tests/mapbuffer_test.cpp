@@ -0,0 +1,316 @@
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <flatbuffers/flexbuffers.h>
+
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "filesystem.h"
+#include "item.h"
+#include "item_location.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_selector.h"
+#include "mapbuffer.h"
+#include "options_helpers.h"
+#include "path_info.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "type_id.h"
+
+static const field_type_str_id field_fd_smoke( "fd_smoke" );
+
+static const furn_str_id furn_f_chair( "f_chair" );
+
+static const itype_id itype_rock( "rock" );
+
+static const mtype_id mon_zombie( "mon_zombie" );
+
+static const ter_str_id ter_t_wall_metal( "t_wall_metal" );
+
+static cata_path quad_file( const tripoint_abs_omt &omt, const std::string &extension )
+{
+    const tripoint_abs_seg seg = project_to<coords::seg>( omt );
+    return PATH_INFO::world_base_save_path_path() / "maps" /
+           string_format( "%d.%d.%d", seg.x(), seg.y(), seg.z() ) /
+           string_format( "%d.%d.%d.%s", omt.x(), omt.y(), omt.z(), extension );
+}
+
+// Loads the quad and returns the json its submaps would be saved as
+static std::string load_and_store_quad( const tripoint_abs_omt &omt )
+{
+    {
+        tinymap tm;
+        tm.load( omt, false );
+    }
+    std::ostringstream out;
+    JsonOut jsout( out );
+    jsout.start_array();
+    for( const point &offset : {
+             point_zero, point_south, point_east, point_south_east
+         } ) {
+        const submap *sm = MAPBUFFER.lookup_submap( project_to<coords::sm>( omt ) + offset );
+        REQUIRE( sm != nullptr );
+        jsout.start_object();
+        sm->store( jsout );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    return out.str();
+}
+
+TEST_CASE( "prefetched_quads_are_adopted", "[map][mapbuffer]" )
+{
+    clear_map();
+    override_option threads( "WORKER_THREADS", "2" );
+
+    // Far enough away that the quads are not part of the reality bubble, so saving drops them.
+    const point_abs_omt bubble_corner = project_to<coords::omt>( get_map().get_abs_sub().xy() );
+    const tripoint_abs_omt saved_omt( bubble_corner.x() + 30, bubble_corner.y(), 0 );
+    const tripoint_abs_omt other_omt( bubble_corner.x() + 32, bubble_corner.y(), 0 );
+    const tripoint marker( 5, 5, 0 );
+    {
+        tinymap tm;
+        tm.load( saved_omt, false );
+        tm.ter_set( marker, ter_t_wall_metal );
+    }
+    MAPBUFFER.save();
+    REQUIRE_FALSE( MAPBUFFER.submap_exists( project_to<coords::sm>( other_omt ) ) );
+
+    MAPBUFFER.reset_prefetch_stats();
+    MAPBUFFER.prefetch_quads( { saved_omt, other_omt } );
+    {
+        tinymap tm;
+        tm.load( saved_omt, false );
+        CHECK( tm.ter( marker ) == ter_t_wall_metal );
+    }
+    CHECK( MAPBUFFER.get_prefetch_stats().hits == 1 );
+    CHECK( MAPBUFFER.get_prefetch_stats().misses == 0 );
+
+    // Quads that were never saved are staged as missing, which still saves a trip to the disk
+    {
+        tinymap tm;
+        tm.load( other_omt, false );
+    }
+    CHECK( MAPBUFFER.get_prefetch_stats().hits == 2 );
+
+    // Without a prefetch the quad is read on the spot
+    MAPBUFFER.save();
+    {
+        tinymap tm;
+        tm.load( saved_omt, false );
+        CHECK( tm.ter( marker ) == ter_t_wall_metal );
+    }
+    CHECK( MAPBUFFER.get_prefetch_stats().misses == 1 );
+}
+
+TEST_CASE( "binary_and_text_quads_round_trip", "[map][mapbuffer]" )
+{
+    clear_map();
+
+    const point_abs_omt bubble_corner = project_to<coords::omt>( get_map().get_abs_sub().xy() );
+    const tripoint_abs_omt omt( bubble_corner.x() + 30, bubble_corner.y() + 2, 0 );
+    {
+        tinymap tm;
+        tm.load( omt, false );
+        tm.ter_set( tripoint( 5, 5, 0 ), ter_t_wall_metal );
+        tm.furn_set( tripoint( 6, 5, 0 ), furn_f_chair );
+        tm.add_item( tripoint_omt_ms( 7, 5, 0 ), item( itype_rock ) );
+        tm.add_field( tripoint( 8, 5, 0 ), field_fd_smoke, 2 );
+    }
+
+    std::string from_text;
+    {
+        override_option binary( "BINARY_MAP_SAVES", "false" );
+        MAPBUFFER.save();
+        REQUIRE( file_exist( quad_file( omt, "map" ) ) );
+        from_text = load_and_store_quad( omt );
+    }
+
+    std::string from_binary;
+    {
+        override_option binary( "BINARY_MAP_SAVES", "true" );
+        MAPBUFFER.save();
+        // Saving again migrates the quad
+        CHECK( file_exist( quad_file( omt, "mapb" ) ) );
+        CHECK_FALSE( file_exist( quad_file( omt, "map" ) ) );
+        from_binary = load_and_store_quad( omt );
+    }
+    CHECK( from_text == from_binary );
+
+    override_option binary( "BINARY_MAP_SAVES", "false" );
+    MAPBUFFER.save();
+    CHECK( file_exist( quad_file( omt, "map" ) ) );
+    CHECK_FALSE( file_exist( quad_file( omt, "mapb" ) ) );
+    CHECK( load_and_store_quad( omt ) == from_text );
+    MAPBUFFER.save();
+}
+
+TEST_CASE( "unchanged_quads_are_not_written_again", "[map][mapbuffer]" )
+{
+    clear_map();
+    get_map().ter_set( tripoint_bub_ms( 5, 5, 0 ), ter_t_wall_metal );
+    MAPBUFFER.save();
+
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().written == 0 );
+    CHECK( MAPBUFFER.get_last_save_stats().unchanged > 0 );
+
+    get_map().ter_set( tripoint_bub_ms( 6, 5, 0 ), ter_t_wall_metal );
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().written == 1 );
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().written == 0 );
+}
+
+TEST_CASE( "item_locations_mark_the_map_only_when_asked", "[map][mapbuffer]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_bub_ms pos( 5, 5, 0 );
+    item &rock = here.add_item( pos, item( itype_rock ) );
+    MAPBUFFER.save();
+
+    item_location loc( map_cursor( pos ), &rock );
+    CHECK( loc->typeId() == itype_rock );
+    CHECK( ( *loc ).typeId() == itype_rock );
+    CHECK( loc.get_item() == &rock );
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().written == 0 );
+
+    loc->set_var( "marked", 1 );
+    loc.mark_modified();
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().written == 1 );
+
+    here.add_spawn( mon_zombie, 1, pos + tripoint_east );
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().written == 1 );
+    here.clear_spawns();
+}
+
+TEST_CASE( "cold_quads_are_evicted_once_saved", "[map][mapbuffer]" )
+{
+    clear_map();
+
+    const point_abs_omt bubble_corner = project_to<coords::omt>( get_map().get_abs_sub().xy() );
+    const tripoint_abs_omt saved_omt( bubble_corner.x() + 30, bubble_corner.y() + 4, 0 );
+    const tripoint_abs_omt changed_omt( bubble_corner.x() + 32, bubble_corner.y() + 4, 0 );
+    const tripoint marker( 5, 5, 0 );
+    {
+        tinymap tm;
+        tm.load( saved_omt, false );
+        tm.ter_set( marker, ter_t_wall_metal );
+    }
+    MAPBUFFER.save();
+    {
+        tinymap tm;
+        tm.load( saved_omt, false );
+        REQUIRE( tm.ter( marker ) == ter_t_wall_metal );
+    }
+    {
+        tinymap tm;
+        tm.load( changed_omt, false );
+        tm.ter_set( marker, ter_t_wall_metal );
+    }
+
+    const size_t held = MAPBUFFER.quad_count();
+    MAPBUFFER.evict_cold_quads( 0 );
+    CHECK( MAPBUFFER.quad_count() < held );
+    CHECK( MAPBUFFER.lookup_submap( get_map().get_abs_sub() ) != nullptr );
+
+    // The saved quad is read back, the changed one was kept
+    {
+        tinymap tm;
+        tm.load( saved_omt, false );
+        CHECK( tm.ter( marker ) == ter_t_wall_metal );
+    }
+    {
+        tinymap tm;
+        tm.load( changed_omt, false );
+        CHECK( tm.ter( marker ) == ter_t_wall_metal );
+    }
+    MAPBUFFER.save();
+}
+
+TEST_CASE( "quad_encoding_benchmark", "[.][map][mapbuffer][benchmark]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            here.furn_set( tripoint_bub_ms( x, y, 0 ), furn_f_chair );
+            here.add_item( tripoint_bub_ms( x, y, 0 ), item( itype_rock ) );
+        }
+    }
+    const submap *sm = MAPBUFFER.lookup_submap( here.get_abs_sub() );
+    REQUIRE( sm != nullptr );
+
+    BENCHMARK( "json text" ) {
+        std::ostringstream out;
+        JsonOut jsout( out );
+        jsout.start_object();
+        sm->store( jsout );
+        jsout.end_object();
+        return out.str().size();
+    };
+    BENCHMARK( "flexbuffer" ) {
+        flexbuffers::Builder builder;
+        JsonOut jsout( builder );
+        jsout.start_object();
+        sm->store( jsout );
+        jsout.end_object();
+        builder.Finish();
+        return builder.GetSize();
+    };
+}
+
+TEST_CASE( "mapbuffer_lookup_benchmark", "[.][map][mapbuffer][benchmark]" )
+{
+    clear_map();
+
+    // About what a long trip leaves in the buffer between two saves
+    const point_abs_omt bubble_corner = project_to<coords::omt>( get_map().get_abs_sub().xy() );
+    const tripoint_abs_sm origin = project_to<coords::sm>( tripoint_abs_omt( bubble_corner.x() + 100,
+                                   bubble_corner.y(), 0 ) );
+    constexpr int side = 200;
+    std::map<tripoint_abs_sm, std::unique_ptr<submap>> tree;
+    std::vector<tripoint_abs_sm> points;
+    for( int x = 0; x < side; ++x ) {
+        for( int y = 0; y < side; ++y ) {
+            const tripoint_abs_sm p = origin + tripoint( x, y, 0 );
+            std::unique_ptr<submap> sm = std::make_unique<submap>();
+            REQUIRE( MAPBUFFER.add_submap( p, sm ) );
+            tree.emplace( p, std::make_unique<submap>() );
+            points.push_back( p );
+        }
+    }
+    // Random lookups, so that neither container gets help from the cache
+    std::vector<tripoint_abs_sm> lookups;
+    for( int i = 0; i < 10000; ++i ) {
+        lookups.push_back( points[rng( 0, points.size() - 1 )] );
+    }
+
+    BENCHMARK( "mapbuffer::lookup_submap" ) {
+        int found = 0;
+        for( const tripoint_abs_sm &p : lookups ) {
+            found += MAPBUFFER.lookup_submap( p ) != nullptr;
+        }
+        return found;
+    };
+    BENCHMARK( "std::map lookup" ) {
+        int found = 0;
+        for( const tripoint_abs_sm &p : lookups ) {
+            found += tree.find( p ) != tree.end();
+        }
+        return found;
+    };
+
+    MAPBUFFER.clear_outside_reality_bubble();
+}
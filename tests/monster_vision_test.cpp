@@ -7,10 +7,10 @@
 #include "mapdata.h"
 #include "monster.h"
 #include "options_helpers.h"
+#include "point.h"
 
 static const ter_str_id ter_t_floor( "t_floor" );
-
-struct tripoint;
+static const ter_str_id ter_t_wall( "t_wall" );
 
 static monster &spawn_and_clear( const tripoint &pos, bool set_floor )
 {
@@ -73,3 +73,26 @@ TEST_CASE( "monsters_should_not_see_through_floors", "[vision]" )
     CHECK( sky.sees( distant ) );
     CHECK( distant.sees( sky ) );
 }
+
+TEST_CASE( "planned_sight_matches_sees", "[vision]" )
+{
+    calendar::turn = midday;
+    clear_map_and_put_player_underground();
+    monster &pet = spawn_and_clear( { 20, 20, 0 }, true );
+    pet.friendly = -1;
+    monster &in_view = spawn_and_clear( { 25, 20, 0 }, true );
+    monster &behind_wall = spawn_and_clear( { 20, 25, 0 }, true );
+    get_map().set( tripoint( 20, 23, 0 ), ter_t_wall, furn_str_id::NULL_ID() );
+    get_map().build_map_cache( 0 );
+    REQUIRE( pet.sees( in_view ) );
+    REQUIRE_FALSE( pet.sees( behind_wall ) );
+
+    pet.plan_sight();
+    CHECK( pet.sees_planned( in_view ) );
+    CHECK_FALSE( pet.sees_planned( behind_wall ) );
+
+    // Whatever moved since is looked at again
+    behind_wall.setpos( tripoint( 22, 20, 0 ) );
+    CHECK( pet.sees_planned( behind_wall ) );
+    pet.forget_planned_sight();
+}
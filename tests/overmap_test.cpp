@@ -32,6 +32,7 @@ static const oter_str_id oter_cabin_east( "cabin_east" );
 static const oter_str_id oter_cabin_north( "cabin_north" );
 static const oter_str_id oter_cabin_south( "cabin_south" );
 static const oter_str_id oter_cabin_west( "cabin_west" );
+static const oter_str_id oter_empty_rock( "empty_rock" );
 
 static const overmap_special_id overmap_special_Cabin( "Cabin" );
 static const overmap_special_id overmap_special_Lab( "Lab" );
@@ -253,6 +254,62 @@ TEST_CASE( "mutable_overmap_placement", "[overmap][slow]" )
     }
 }
 
+TEST_CASE( "find_closest_follows_terrain_changes", "[overmap]" )
+{
+    overmap_buffer.clear();
+    const tripoint_abs_omt origin( 90, 90, -5 );
+    const tripoint_abs_omt far_cabin( 110, 100, -5 );
+    const tripoint_abs_omt near_cabin( 95, 90, -5 );
+
+    omt_find_params params;
+    params.types = { { "cabin", ot_match_type::type } };
+    params.search_range = 40;
+    params.min_z = -5;
+    params.max_z = -5;
+
+    REQUIRE( overmap_buffer.find_all( origin, params ).empty() );
+
+    overmap_buffer.ter_set( far_cabin, oter_cabin.id() );
+    CHECK( overmap_buffer.find_closest( origin, params ) == far_cabin );
+
+    overmap_buffer.ter_set( near_cabin, oter_cabin_north.id() );
+    CHECK( overmap_buffer.find_closest( origin, params ) == near_cabin );
+    CHECK( overmap_buffer.find_all( origin, params ) ==
+           std::vector<tripoint_abs_omt> { near_cabin, far_cabin } );
+
+    overmap_buffer.ter_set( near_cabin, oter_empty_rock.id() );
+    CHECK( overmap_buffer.find_closest( origin, params ) == far_cabin );
+
+    params.min_distance = 30;
+    CHECK( overmap_buffer.find_closest( origin, params ) == overmap::invalid_tripoint );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "find_all_stays_on_the_origin_z_level_by_default", "[overmap]" )
+{
+    overmap_buffer.clear();
+    const tripoint_abs_omt origin( 90, 90, -5 );
+    const tripoint_abs_omt same_level( 95, 90, -5 );
+    const tripoint_abs_omt level_above( 100, 90, -4 );
+
+    omt_find_params params;
+    params.types = { { "cabin", ot_match_type::type } };
+    params.search_range = 40;
+
+    overmap_buffer.ter_set( same_level, oter_cabin.id() );
+    overmap_buffer.ter_set( level_above, oter_cabin.id() );
+
+    CHECK( overmap_buffer.find_all( origin, params ) ==
+           std::vector<tripoint_abs_omt> { same_level } );
+    CHECK( overmap_buffer.find_random( origin, params ) == same_level );
+
+    params.min_z = -5;
+    params.max_z = -4;
+    CHECK( overmap_buffer.find_all( origin, params ) ==
+           std::vector<tripoint_abs_omt> { same_level, level_above } );
+    overmap_buffer.clear();
+}
+
 static bool tally_items( std::unordered_map<itype_id, float> &global_item_count,
                          std::unordered_map<itype_id, int> &item_count, tinymap &tm )
 {
@@ -0,0 +1,61 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cata_catch.h"
+#include "profiling.h"
+
+static const profiling::zone_summary &summary_of( const std::vector<profiling::zone_summary> &all,
+        profiling::zone z )
+{
+    return all[static_cast<int>( z )];
+}
+
+TEST_CASE( "profiling_zones_are_summed_per_turn", "[profiling]" )
+{
+    profiling::set_enabled( true );
+    for( int turn = 0; turn < 10; ++turn ) {
+        profiling::scoped_turn profile_turn;
+        for( int i = 0; i < 3; ++i ) {
+            profiling::scoped_zone zone( profiling::zone::monmove );
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+        }
+        if( turn % 2 == 0 ) {
+            profiling::scoped_zone zone( profiling::zone::process_sounds );
+        }
+    }
+    profiling::set_enabled( false );
+
+    // Nothing is recorded while disabled
+    {
+        profiling::scoped_turn profile_turn;
+        profiling::scoped_zone zone( profiling::zone::monmove );
+    }
+
+    const std::vector<profiling::zone_summary> summaries = profiling::summarize();
+    REQUIRE( summaries.size() == static_cast<size_t>( profiling::num_zones ) );
+
+    const profiling::zone_summary &turn = summary_of( summaries, profiling::zone::do_turn );
+    CHECK( turn.turns == 10 );
+    CHECK( turn.calls_per_turn == Approx( 1.0 ) );
+
+    const profiling::zone_summary &monmove = summary_of( summaries, profiling::zone::monmove );
+    CHECK( monmove.turns == 10 );
+    CHECK( monmove.calls_per_turn == Approx( 3.0 ) );
+    CHECK( monmove.median.count() >= 600 );
+    CHECK( monmove.median <= monmove.p95 );
+    CHECK( monmove.p95 <= monmove.max );
+    CHECK( turn.mean >= monmove.mean );
+    int histogram_turns = 0;
+    for( const int count : monmove.histogram ) {
+        histogram_turns += count;
+    }
+    CHECK( histogram_turns == 10 );
+
+    const profiling::zone_summary &sounds = summary_of( summaries, profiling::zone::process_sounds );
+    CHECK( sounds.turns == 5 );
+    CHECK( sounds.calls_per_turn == Approx( 0.5 ) );
+
+    CHECK( summary_of( summaries, profiling::zone::process_items ).turns == 0 );
+    CHECK_FALSE( profiling::report().empty() );
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "cata_utility.h"
+#include "item.h"
+#include "recipe.h"
+#include "recipe_dictionary.h"
+#include "requirements.h"
+#include "skill.h"
+#include "type_id.h"
+
+static recipe_subset all_recipes()
+{
+    recipe_subset subset;
+    for( const std::pair<const recipe_id, recipe> &r : recipe_dict ) {
+        subset.include( &r.second );
+    }
+    return subset;
+}
+
+// What recipe_subset::search returned before it was indexed
+static std::vector<const recipe *> search_all( const recipe_subset &subset,
+        const std::string &txt, const recipe_subset::search_type key )
+{
+    std::vector<const recipe *> res;
+    for( const recipe *r : subset ) {
+        if( !*r || r->obsolete ) {
+            continue;
+        }
+        bool match = false;
+        switch( key ) {
+            case recipe_subset::search_type::name:
+                match = lcmatch( r->result_name(), txt );
+                break;
+            case recipe_subset::search_type::exclude_name:
+                match = !lcmatch( r->result_name(), txt );
+                break;
+            case recipe_subset::search_type::skill:
+                match = ( r->skill_used && lcmatch( r->skill_used->name(), txt ) ) ||
+                std::any_of( r->required_skills.begin(), r->required_skills.end(),
+                [&]( const std::pair<const skill_id, int> &e ) {
+                    return lcmatch( e.first->name(), txt );
+                } );
+                break;
+            case recipe_subset::search_type::primary_skill:
+                match = lcmatch( r->skill_used->name(), txt );
+                break;
+            case recipe_subset::search_type::component:
+                for( const std::vector<item_comp> &opts : r->simple_requirements().get_components() ) {
+                    for( const item_comp &ic : opts ) {
+                        match |= lcmatch( item::nname( ic.type ), txt );
+                    }
+                }
+                break;
+            case recipe_subset::search_type::tool:
+                for( const std::vector<tool_comp> &opts : r->simple_requirements().get_tools() ) {
+                    for( const tool_comp &tc : opts ) {
+                        match |= lcmatch( tc.to_string(), txt );
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        if( match ) {
+            res.push_back( r );
+        }
+    }
+    return res;
+}
+
+TEST_CASE( "indexed_recipe_search_matches_every_recipe_search", "[recipe][crafting]" )
+{
+    const recipe_subset subset = all_recipes();
+    REQUIRE( subset.size() > 100 );
+
+    using search_type = recipe_subset::search_type;
+    const std::vector<std::pair<search_type, std::string>> queries = {
+        { search_type::name, "ax" },
+        { search_type::name, "knife" },
+        { search_type::name, "Leather" },
+        { search_type::name, "no recipe makes this" },
+        { search_type::exclude_name, "knife" },
+        { search_type::skill, "fabrication" },
+        { search_type::skill, "COOK" },
+        { search_type::primary_skill, "tailor" },
+        { search_type::component, "rag" },
+        { search_type::component, "steel" },
+        { search_type::tool, "hammer" },
+        { search_type::tool, "charge" },
+    };
+    for( const std::pair<search_type, std::string> &query : queries ) {
+        CAPTURE( static_cast<int>( query.first ), query.second );
+        const std::vector<const recipe *> expected = search_all( subset, query.second, query.first );
+        CHECK( subset.search( query.second, query.first ) == expected );
+    }
+}
+
+TEST_CASE( "recipe_search_benchmark", "[.][recipe][crafting][benchmark]" )
+{
+    const recipe_subset subset = all_recipes();
+    // Typing a name into the crafting menu searches for every prefix of it
+    const std::string typed = "leather armor";
+
+    BENCHMARK( "search names while typing" ) {
+        size_t found = 0;
+        for( size_t len = 1; len <= typed.size(); ++len ) {
+            found += subset.search( typed.substr( 0, len ) ).size();
+        }
+        return found;
+    };
+    BENCHMARK( "search components" ) {
+        return subset.search( "steel", recipe_subset::search_type::component ).size();
+    };
+}
@@ -0,0 +1,53 @@
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "cata_catch.h"
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "path_info.h"
+#include "save_writer.h"
+
+static std::string read_contents( const cata_path &path )
+{
+    std::string contents;
+    read_from_file( path, [&contents]( std::istream & fin ) {
+        std::getline( fin, contents );
+    } );
+    return contents;
+}
+
+TEST_CASE( "deferred_saves_are_written_in_order", "[save_writer]" )
+{
+    assure_dir_exist( PATH_INFO::world_base_save_path() );
+    const cata_path path = PATH_INFO::world_base_save_path_path() / "save_writer_test.txt";
+
+    {
+        cata::deferred_saves deferred;
+        for( int i = 0; i < 10; ++i ) {
+            write_to_file( path, [i]( std::ostream & fout ) {
+                fout << "version " << i;
+            } );
+        }
+    }
+    // Reading waits for the queued writes
+    CHECK( read_contents( path ) == "version 9" );
+
+    {
+        cata::deferred_saves deferred;
+        write_to_file( path, []( std::ostream & fout ) {
+            fout << "deferred";
+        } );
+    }
+    // A direct write has to wait for the queued one, or it would be overwritten
+    write_to_file( path, []( std::ostream & fout ) {
+        fout << "direct";
+    } );
+    get_save_writer().flush();
+    CHECK_FALSE( get_save_writer().is_queued( path.get_unrelative_path() ) );
+    CHECK( read_contents( path ) == "direct" );
+    CHECK( get_save_writer().take_errors().empty() );
+
+    remove_file( path.get_unrelative_path() );
+}
@@ -0,0 +1,150 @@
+#include <array>
+#include <memory>
+
+#include "cata_catch.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "type_id.h"
+
+static const furn_str_id furn_f_generator_broken( "f_generator_broken" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
+using scent_grid = std::array<std::array<int, MAPSIZE_Y>, MAPSIZE_X>;
+using flag_grid = std::array<std::array<bool, MAPSIZE_Y>, MAPSIZE_X>;
+
+static constexpr int test_scent_radius = 40;
+
+// The per-cell diffusion that scent_map::update used to do, kept as the golden reference.
+static void reference_scent_update( scent_grid &grscent, const tripoint &center, map &m )
+{
+    scent_grid sum_3_scent_y;
+    scent_grid squares_used_y;
+    flag_grid blocks_scent;
+    flag_grid reduces_scent;
+    const int scentmap_minx = center.x - test_scent_radius;
+    const int scentmap_maxx = center.x + test_scent_radius;
+    const int scentmap_miny = center.y - test_scent_radius;
+    const int scentmap_maxy = center.y + test_scent_radius;
+    const int diffusivity = 100;
+
+    m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks_scent[x][i] ) {
+                    if( reduces_scent[x][i] ) {
+                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
+                        squares_used_y[y][x] += 2;
+                    } else {
+                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
+                        squares_used_y[y][x] += 10;
+                    }
+                }
+            }
+        }
+    }
+    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            int &scent_here = grscent[x][y];
+            if( !blocks_scent[x][y] ) {
+                const int squares_used = squares_used_y[y][x - 1]
+                                         + squares_used_y[y][x]
+                                         + squares_used_y[y][x + 1];
+                const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+                scent_here = ( temp_scent + this_diffusivity * ( sum_3_scent_y[y][x - 1]
+                               + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1] ) ) / ( 1000 * 10 );
+            } else {
+                scent_here = 0;
+            }
+        }
+    }
+}
+
+static void build_scent_test_map()
+{
+    map &here = get_map();
+    clear_map();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const tripoint_bub_ms p( x, y, 0 );
+            here.ter_set( p, one_in( 6 ) ? ter_t_wall : ter_t_floor );
+            if( one_in( 8 ) ) {
+                here.furn_set( p, furn_f_generator_broken );
+            }
+        }
+    }
+}
+
+static const tripoint scent_center( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+
+TEST_CASE( "scent_diffusion_matches_reference", "[scent]" )
+{
+    build_scent_test_map();
+    map &here = get_map();
+    std::unique_ptr<scent_map> scent = std::make_unique<scent_map>( *g );
+    std::unique_ptr<scent_grid> expected = std::make_unique<scent_grid>();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const int value = one_in( 3 ) ? rng( 0, 1000 ) : 0;
+            scent->set_unsafe( tripoint( x, y, 0 ), value );
+            ( *expected )[x][y] = value;
+        }
+    }
+
+    // Moving around, so that every update does something
+    for( int turn = 0; turn < 20; ++turn ) {
+        const tripoint center = scent_center + point( turn % 5, turn / 5 );
+        reference_scent_update( *expected, center, here );
+        scent->update( center, here );
+    }
+
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( scent->get_unsafe( tripoint( x, y, 0 ) ) != ( *expected )[x][y] ) {
+                ++mismatches;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "scent_map_update_benchmark", "[.][scent][benchmark]" )
+{
+    build_scent_test_map();
+    map &here = get_map();
+    std::unique_ptr<scent_map> scent = std::make_unique<scent_map>( *g );
+    std::unique_ptr<scent_grid> reference = std::make_unique<scent_grid>();
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const int value = rng( 0, 1000 );
+            scent->set_unsafe( tripoint( x, y, 0 ), value );
+            ( *reference )[x][y] = value;
+        }
+    }
+
+    int turn = 0;
+    BENCHMARK( "scent_map::update" ) {
+        // Alternate the center so that the update is never skipped for standing still
+        ++turn;
+        scent->update( scent_center + point( turn % 2, 0 ), here );
+        return scent->get_unsafe( scent_center );
+    };
+    BENCHMARK( "reference per-cell update" ) {
+        ++turn;
+        reference_scent_update( *reference, scent_center + point( turn % 2, 0 ), here );
+        return ( *reference )[scent_center.x][scent_center.y];
+    };
+}
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdio>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 #include <vector>
@@ -124,6 +125,20 @@ static void randomly_fill_transparency(
     } );
 }
 
+// Like randomly_fill_transparency, but also with tiles partially blocking sight like smoke does
+static void randomly_fill_partial_transparency( cata::mdarray<float, point_bub_ms> &transparency_cache )
+{
+    transparency_cache.fill_from_callable( []() {
+        const int roll = rng( 0, 19 );
+        if( roll < 2 ) {
+            return LIGHT_TRANSPARENCY_SOLID;
+        } else if( roll < 4 ) {
+            return LIGHT_TRANSPARENCY_OPEN_AIR * rng( 2, 10 );
+        }
+        return LIGHT_TRANSPARENCY_OPEN_AIR;
+    } );
+}
+
 static bool is_nonzero( const float x )
 {
     return x != 0;
@@ -151,6 +166,20 @@ bool grids_are_equivalent(
     return true;
 }
 
+static bool grids_are_identical(
+    const cata::mdarray<float, point_bub_ms> &control,
+    const cata::mdarray<float, point_bub_ms> &experiment )
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( control[x][y] != experiment[x][y] ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 template<typename Exp>
 void print_grid_comparison(
     const point_bub_ms &offset,
@@ -385,11 +414,31 @@ static void do_3d_benchmark(
     const std::chrono::high_resolution_clock::time_point end =
         std::chrono::high_resolution_clock::now();
 
+    // The same casts over bit planes, which is what the seen cache is built from
+    std::unique_ptr<std::array<transparency_planes, OVERMAP_LAYERS>> planes =
+                std::make_unique<std::array<transparency_planes, OVERMAP_LAYERS>>();
+    array_of_transparency_planes transparency_planes_array;
+    for( int z = 0; z < OVERMAP_LAYERS; z++ ) {
+        ( *planes )[z].build( *transparency_caches[z] );
+        transparency_planes_array[z] = &( *planes )[z];
+    }
+    const std::chrono::high_resolution_clock::time_point start_planes =
+        std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        cast_zlight( seen_caches, transparency_planes_array, floor_caches, origin, 0, 1.0 );
+    }
+    const std::chrono::high_resolution_clock::time_point end_planes =
+        std::chrono::high_resolution_clock::now();
+
     if( iterations > 1 ) {
         const long long diff =
             std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
         printf( "cast_zlight() executed %d times in %lld microseconds.\n",
                 iterations, diff );
+        const long long diff_planes = std::chrono::duration_cast<std::chrono::microseconds>
+                                      ( end_planes - start_planes ).count();
+        printf( "cast_zlight() on bit planes executed %d times in %lld microseconds.\n",
+                iterations, diff_planes );
     }
 }
 
@@ -595,6 +644,23 @@ static void run_spot_check( const grid_overlay &test_case, const grid_overlay &e
     if( fov_3d ) {
         cast_zlight<float, sight_calc, sight_check, accumulate_transparency>( seen_squares,
                 transparency_cache, floor_cache, ORIGIN - tripoint( 0, 0, OVERMAP_DEPTH ), 0, 1.0 );
+
+        // Casting over bit planes has to give exactly the same result
+        array_of_grids_of<float> seen_from_planes;
+        array_of_transparency_planes planes;
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            caches[z]->vision_transparency_planes.build( caches[z]->transparency_cache );
+            seen_from_planes[z] = &caches[z]->camera_cache;
+            planes[z] = &caches[z]->vision_transparency_planes;
+        }
+        cast_zlight( seen_from_planes, planes, floor_cache,
+                     ORIGIN - tripoint( 0, 0, OVERMAP_DEPTH ), 0, 1.0 );
+        bool planes_match = true;
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            planes_match &= grids_are_identical( caches[z]->seen_cache, caches[z]->camera_cache );
+        }
+        CHECK( planes_match );
+
         get_map().seen_cache_process_ledges( seen_squares, floor_cache, ORIGIN.raw() - tripoint( 0, 0,
                                              OVERMAP_DEPTH ) );
     } else {
@@ -1096,6 +1162,79 @@ TEST_CASE( "shadowcasting_floating_wall", "[shadowcasting]" )
     run_spot_check( test_case, expected_results, true );
 }
 
+TEST_CASE( "shadowcasting_bit_planes_match_float_caches", "[shadowcasting]" )
+{
+    struct test_grids {
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> transparency = {};
+        std::array<cata::mdarray<bool, point_bub_ms>, OVERMAP_LAYERS> floor = {};
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> seen = {};
+        std::array<cata::mdarray<float, point_bub_ms>, OVERMAP_LAYERS> seen_from_planes = {};
+        std::array<transparency_planes, OVERMAP_LAYERS> planes;
+    };
+    std::unique_ptr<test_grids> grids = std::make_unique<test_grids>();
+
+    array_of_grids_of<const float> transparency_caches;
+    array_of_grids_of<const bool> floor_caches;
+    array_of_grids_of<float> seen_caches;
+    array_of_grids_of<float> seen_from_planes_caches;
+    array_of_transparency_planes planes;
+    for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+        randomly_fill_partial_transparency( grids->transparency[z] );
+        grids->floor[z].fill_from_callable( []() {
+            return one_in( 3 );
+        } );
+        grids->planes[z].build( grids->transparency[z] );
+        transparency_caches[z] = &grids->transparency[z];
+        floor_caches[z] = &grids->floor[z];
+        seen_caches[z] = &grids->seen[z];
+        seen_from_planes_caches[z] = &grids->seen_from_planes[z];
+        planes[z] = &grids->planes[z];
+    }
+    CHECK( grids->planes[OVERMAP_DEPTH].partial_tiles() > 0 );
+
+    for( const tripoint_bub_ms &origin : {
+             tripoint_bub_ms( 65, 65, 0 ), tripoint_bub_ms( 3, 120, -2 ), tripoint_bub_ms( 130, 0, 10 )
+         } ) {
+        CAPTURE( origin );
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            grids->seen[z].fill( LIGHT_TRANSPARENCY_SOLID );
+            grids->seen_from_planes[z].fill( LIGHT_TRANSPARENCY_SOLID );
+        }
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            seen_caches, transparency_caches, floor_caches, origin, 2, 1.0 );
+        cast_zlight( seen_from_planes_caches, planes, floor_caches, origin, 2, 1.0 );
+        for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
+            CAPTURE( z );
+            CHECK( grids_are_identical( grids->seen[z], grids->seen_from_planes[z] ) );
+        }
+    }
+}
+
+TEST_CASE( "transparency_planes_keep_the_values_they_are_set_to", "[shadowcasting]" )
+{
+    std::unique_ptr<cata::mdarray<float, point_bub_ms>> transparency =
+                std::make_unique<cata::mdarray<float, point_bub_ms>>();
+    std::unique_ptr<cata::mdarray<float, point_bub_ms>> unpacked =
+                std::make_unique<cata::mdarray<float, point_bub_ms>>();
+    std::unique_ptr<transparency_planes> planes = std::make_unique<transparency_planes>();
+    randomly_fill_partial_transparency( *transparency );
+    planes->build( *transparency );
+
+    // Move tiles between open air, solid and partial in every direction
+    const std::array<float, 4> values = {
+        LIGHT_TRANSPARENCY_OPEN_AIR, LIGHT_TRANSPARENCY_SOLID, 0.2f, 0.5f
+    };
+    for( int i = 0; i < 2000; ++i ) {
+        const int x = rng( 0, MAPSIZE_X - 1 );
+        const int y = rng( 0, MAPSIZE_Y - 1 );
+        const float value = values[rng( 0, values.size() - 1 )];
+        ( *transparency )[x][y] = value;
+        planes->set( x, y, value );
+    }
+    planes->unpack( *unpacked );
+    CHECK( grids_are_identical( *transparency, *unpacked ) );
+}
+
 // Some random edge cases aren't matching.
 TEST_CASE( "shadowcasting_runoff", "[.]" )
 {
@@ -0,0 +1,27 @@
+#include "calendar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "sight_cache.h"
+
+TEST_CASE( "sight_cache_is_symmetric_and_turn_scoped", "[vision]" )
+{
+    sight_cache cache;
+    const tripoint_bub_ms a( 10, 20, 0 );
+    const tripoint_bub_ms b( 30, 5, -1 );
+
+    CHECK( cache.get( a, b, true ) == -1 );
+    cache.insert( a, b, true, true );
+    cache.insert( a, b, false, false );
+    CHECK( cache.get( a, b, true ) == 1 );
+    CHECK( cache.get( b, a, true ) == 1 );
+    CHECK( cache.get( b, a, false ) == 0 );
+    CHECK( cache.stats().hits == 3 );
+    CHECK( cache.stats().misses == 1 );
+
+    cache.invalidate();
+    CHECK( cache.get( a, b, true ) == -1 );
+
+    cache.insert( a, b, true, true );
+    calendar::turn += 1_turns;
+    CHECK( cache.get( a, b, true ) == -1 );
+}
@@ -0,0 +1,80 @@
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "cata_catch.h"
+#include "slab_pool.h"
+#include "submap.h"
+
+TEST_CASE( "slab_pool_reuses_freed_blocks", "[slab_pool]" )
+{
+    cata::slab_pool pool( 24, 4 );
+    std::vector<void *> blocks;
+    for( int i = 0; i < 5; ++i ) {
+        blocks.push_back( pool.allocate() );
+    }
+    CHECK( pool.stats().slabs == 2 );
+    CHECK( pool.stats().live == 5 );
+    CHECK( pool.stats().free == 3 );
+    CHECK( pool.stats().block_size % alignof( std::max_align_t ) == 0 );
+
+    void *freed = blocks[2];
+    pool.deallocate( freed );
+    CHECK( pool.stats().live == 4 );
+    CHECK( pool.stats().free == 4 );
+    CHECK( pool.allocate() == freed );
+    CHECK( pool.stats().slabs == 2 );
+}
+
+TEST_CASE( "submaps_come_from_the_pool", "[slab_pool][map]" )
+{
+    const size_t live_before = submap::allocation_stats().live;
+    const size_t tiles_before = maptile_soa::allocation_stats().live;
+    {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        sm->ensure_nonuniform();
+        CHECK( submap::allocation_stats().live == live_before + 1 );
+        CHECK( maptile_soa::allocation_stats().live == tiles_before + 1 );
+    }
+    CHECK( submap::allocation_stats().live == live_before );
+    CHECK( maptile_soa::allocation_stats().live == tiles_before );
+}
+
+// What fast travel does to the heap: whole rows of non-uniform submaps are dropped and
+// created again with every shift.
+TEST_CASE( "submap_allocation_benchmark", "[.][slab_pool][map][benchmark]" )
+{
+    constexpr int row = 11 * 21;
+    std::vector<std::unique_ptr<submap>> submaps( row );
+
+    BENCHMARK( "pooled submaps" ) {
+        for( std::unique_ptr<submap> &sm : submaps ) {
+            sm = std::make_unique<submap>();
+            sm->ensure_nonuniform();
+        }
+        return submaps.size();
+    };
+
+    // The same objects on the general heap, which is what operator new did before
+    std::vector<submap *> heap_submaps( row, nullptr );
+    std::vector<maptile_soa *> heap_tiles( row, nullptr );
+    BENCHMARK( "heap submaps" ) {
+        for( int i = 0; i < row; ++i ) {
+            if( heap_submaps[i] != nullptr ) {
+                heap_tiles[i]->~maptile_soa();
+                ::operator delete( heap_tiles[i] );
+                heap_submaps[i]->~submap();
+                ::operator delete( heap_submaps[i] );
+            }
+            heap_submaps[i] = ::new( ::operator new( sizeof( submap ) ) ) submap();
+            heap_tiles[i] = ::new( ::operator new( sizeof( maptile_soa ) ) ) maptile_soa();
+        }
+        return heap_submaps.size();
+    };
+    for( int i = 0; i < row; ++i ) {
+        heap_tiles[i]->~maptile_soa();
+        ::operator delete( heap_tiles[i] );
+        heap_submaps[i]->~submap();
+        ::operator delete( heap_submaps[i] );
+    }
+}
@@ -0,0 +1,59 @@
+#include <vector>
+
+#include "cata_catch.h"
+#include "creature_tracker.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "rng.h"
+#include "sounds.h"
+
+static const tripoint sound_origin( HALF_MAPSIZE_X, HALF_MAPSIZE_Y, 0 );
+
+TEST_CASE( "sounds_reach_monsters_in_hearing_range", "[sounds][monster]" )
+{
+    clear_map();
+    sounds::reset_sounds();
+    monster &near = spawn_test_monster( "mon_zombie", sound_origin + point( 10, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", sound_origin + point( -SEEX * 4, 0 ) );
+    monster &below = spawn_test_monster( "mon_zombie", sound_origin + tripoint( 0, 5, -2 ) );
+    REQUIRE( near.wandf == 0 );
+    REQUIRE( far.wandf == 0 );
+    REQUIRE( below.wandf == 0 );
+
+    sounds::sound( sound_origin, 20, sounds::sound_t::combat, "BANG!" );
+    sounds::process_sounds();
+
+    CHECK( near.wandf > 0 );
+    CHECK( far.wandf == 0 );
+    CHECK( below.wandf == 0 );
+    sounds::reset_sounds();
+}
+
+TEST_CASE( "process_sounds_benchmark", "[.][sounds][benchmark]" )
+{
+    clear_map();
+    sounds::reset_sounds();
+    for( int i = 0; i < 500; ++i ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        if( !get_creature_tracker().creature_at( p ) ) {
+            spawn_test_monster( "mon_zombie", p );
+        }
+    }
+    std::vector<tripoint> sources;
+    for( int i = 0; i < 50; ++i ) {
+        sources.emplace_back( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+    }
+
+    BENCHMARK( "50 sounds, 500 monsters" ) {
+        for( const tripoint &p : sources ) {
+            sounds::sound( p, rng( 5, 40 ), sounds::sound_t::combat, "BANG!" );
+        }
+        sounds::process_sounds();
+        sounds::reset_sounds();
+        return sources.size();
+    };
+    clear_map();
+}
@@ -1,10 +1,14 @@
 #include "cata_catch.h"
 #include "submap.h"
 
+#include "colony.h"
 #include "game_constants.h"
+#include "item.h"
 #include "point.h"
 #include "type_id.h"
 
+static const itype_id itype_test_rock( "test_rock" );
+
 TEST_CASE( "submap_rotation", "[submap]" )
 {
     // Corners are labelled starting from the upper-left one, clockwise.
@@ -115,3 +119,30 @@ TEST_CASE( "submap_rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_squares_allocate_items_in_small_groups", "[submap][item]" )
+{
+    submap sm;
+    sm.ensure_nonuniform();
+    const point_sm_ms p( 3, 4 );
+    cata::colony<item> &items = sm.get_items( p );
+    item &first = *items.insert( item( itype_test_rock ) );
+    CHECK( items.capacity() == maptile_soa::item_group_size );
+
+    // Growing the pile keeps the items where they are
+    for( int i = 0; i < 50; ++i ) {
+        items.insert( item( itype_test_rock ) );
+    }
+    CHECK( &*items.begin() == &first );
+
+    const submap_item_stats stats = sm.item_stats();
+    CHECK( stats.items == 51 );
+    CHECK( stats.slots == items.capacity() );
+    CHECK( stats.bytes > 51 * sizeof( item ) );
+
+    // Copies of the submap keep the small groups
+    submap copy = sm.get_revert_submap();
+    cata::colony<item> &copied_items = copy.get_items( point_sm_ms( 5, 5 ) );
+    copied_items.insert( item( itype_test_rock ) );
+    CHECK( copied_items.capacity() == maptile_soa::item_group_size );
+}